@@ -0,0 +1,181 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include <stdgpu/atomic.cuh>            // stdgpu::atomic_ref
+#include <stdgpu/memory.h>              // createDeviceArray, destroyDeviceArray
+#include <stdgpu/mutex.cuh>             // stdgpu::mutex_array, stdgpu::shared_mutex_array, stdgpu::lock_guard
+#include <stdgpu/platform.h>            // STDGPU_DEVICE_ONLY
+
+
+
+struct increment_try_lock
+{
+    stdgpu::mutex_array locks;
+    int* counters;
+
+    increment_try_lock(stdgpu::mutex_array locks,
+                       int* counters)
+        : locks(locks),
+          counters(counters)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const int i)
+    {
+        stdgpu::mutex_array::reference lock = locks[i % locks.size()];
+
+        // Spin on the atomic operation until the mutex is acquired
+        bool done = false;
+        while (!done)
+        {
+            if (lock.try_lock())
+            {
+                counters[i % locks.size()] += 1;
+                done = true;
+                lock.unlock();
+            }
+        }
+    }
+};
+
+
+struct increment_lock
+{
+    stdgpu::mutex_array locks;
+    int* counters;
+
+    increment_lock(stdgpu::mutex_array locks,
+                   int* counters)
+        : locks(locks),
+          counters(counters)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const int i)
+    {
+        // Wait with exponential backoff while the mutex is held by another thread
+        stdgpu::lock_guard<stdgpu::mutex_array::reference> guard(locks[i % locks.size()]);
+
+        counters[i % locks.size()] += 1;
+    }
+};
+
+
+struct read_exclusive
+{
+    stdgpu::mutex_array locks;
+    int* counters;
+    int* sums;
+
+    read_exclusive(stdgpu::mutex_array locks,
+                   int* counters,
+                   int* sums)
+        : locks(locks),
+          counters(counters),
+          sums(sums)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const int i)
+    {
+        int value;
+        {
+            stdgpu::lock_guard<stdgpu::mutex_array::reference> guard(locks[i % locks.size()]);
+            value = counters[i % locks.size()];
+        }
+        stdgpu::atomic_ref<int>(sums[i % locks.size()]).fetch_add(value);
+    }
+};
+
+
+struct read_shared
+{
+    stdgpu::shared_mutex_array locks;
+    int* counters;
+    int* sums;
+
+    read_shared(stdgpu::shared_mutex_array locks,
+                int* counters,
+                int* sums)
+        : locks(locks),
+          counters(counters),
+          sums(sums)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const int i)
+    {
+        int value;
+        {
+            // Readers of the same entry do not exclude each other
+            stdgpu::shared_lock_guard<stdgpu::shared_mutex_array::reference> guard(locks[i % locks.size()]);
+            value = counters[i % locks.size()];
+        }
+        stdgpu::atomic_ref<int>(sums[i % locks.size()]).fetch_add(value);
+    }
+};
+
+
+template <typename F>
+double
+operations_per_second(const int n,
+                      F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    thrust::for_each(thrust::counting_iterator<int>(0), thrust::counting_iterator<int>(n),
+                     f);
+    auto end = std::chrono::steady_clock::now();
+
+    return static_cast<double>(n) / std::chrono::duration<double>(end - start).count();
+}
+
+
+int
+main()
+{
+    const int n = 1000000;                  // Operations
+    const stdgpu::index_t hot = 4;          // Heavily contended mutexes
+
+    stdgpu::mutex_array locks = stdgpu::mutex_array::createDeviceObject(hot);
+    stdgpu::shared_mutex_array shared_locks = stdgpu::shared_mutex_array::createDeviceObject(hot);
+    int* d_counters = createDeviceArray<int>(hot, 0);
+    int* d_sums = createDeviceArray<int>(hot, 0);
+
+    std::cout << "Increments on " << hot << " mutexes" << std::endl;
+    std::cout << "  try_lock spin loop   : " << operations_per_second(n, increment_try_lock(locks, d_counters)) << " operations per second" << std::endl;
+    std::cout << "  lock with backoff    : " << operations_per_second(n, increment_lock(locks, d_counters)) << " operations per second" << std::endl;
+
+    std::cout << "Reads of " << hot << " entries" << std::endl;
+    std::cout << "  mutex_array          : " << operations_per_second(n, read_exclusive(locks, d_counters, d_sums)) << " operations per second" << std::endl;
+    std::cout << "  shared_mutex_array   : " << operations_per_second(n, read_shared(shared_locks, d_counters, d_sums)) << " operations per second" << std::endl;
+
+    destroyDeviceArray<int>(d_sums);
+    destroyDeviceArray<int>(d_counters);
+    stdgpu::shared_mutex_array::destroyDeviceObject(shared_locks);
+    stdgpu::mutex_array::destroyDeviceObject(locks);
+}
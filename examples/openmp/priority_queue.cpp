@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+
+#include <stdgpu/iterator.h>            // device_begin, device_end
+#include <stdgpu/memory.h>              // createDeviceArray, destroyDeviceArray
+#include <stdgpu/platform.h>            // STDGPU_HOST_DEVICE
+#include <stdgpu/priority_queue.cuh>    // stdgpu::priority_queue
+
+
+
+STDGPU_HOST_DEVICE int
+next_event_time(const int time,
+                const int i)
+{
+    // Schedule a follow-up event at some pseudo-random point in the future
+    return time + 1 + static_cast<int>((static_cast<unsigned int>(i) * 2654435761u) % 1000u);
+}
+
+
+struct initial_event
+{
+    STDGPU_HOST_DEVICE int
+    operator()(const int i) const
+    {
+        return next_event_time(0, i);
+    }
+};
+
+
+struct reschedule_sorted
+{
+    int* events;
+
+    reschedule_sorted(int* events)
+        : events(events)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const int i)
+    {
+        // Replace the processed event by its follow-up
+        events[i] = next_event_time(events[i], i);
+    }
+};
+
+
+struct reschedule_queue
+{
+    stdgpu::priority_queue<int> queue;
+
+    reschedule_queue(stdgpu::priority_queue<int> queue)
+        : queue(queue)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const int i)
+    {
+        thrust::pair<int, bool> event = queue.pop_min();
+
+        if (event.second)
+        {
+            queue.push(next_event_time(event.first, i));
+        }
+    }
+};
+
+
+int
+main()
+{
+    const stdgpu::index_t n = 100000;           // Pending events
+    const stdgpu::index_t batch = 1000;         // Events processed per iteration
+    const stdgpu::index_t iterations = 100;
+
+    int* d_events = createDeviceArray<int>(n);
+    stdgpu::priority_queue<int> queue = stdgpu::priority_queue<int>::createDeviceObject(n, 16);
+
+    thrust::transform(thrust::counting_iterator<int>(0), thrust::counting_iterator<int>(n),
+                      stdgpu::device_begin(d_events),
+                      initial_event());
+
+    queue.push(stdgpu::device_cbegin(d_events), stdgpu::device_cend(d_events));
+
+    // Sort every iteration : The whole array is sorted to find the next batch of events
+
+    auto start = std::chrono::steady_clock::now();
+    for (stdgpu::index_t i = 0; i < iterations; ++i)
+    {
+        thrust::sort(stdgpu::device_begin(d_events), stdgpu::device_end(d_events));
+        thrust::for_each(thrust::counting_iterator<int>(0), thrust::counting_iterator<int>(batch),
+                         reschedule_sorted(d_events));
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "Sort every iteration : " << static_cast<double>(iterations * batch) / seconds << " events per second" << std::endl;
+
+    // Priority queue : Only the processed events are touched, at the cost of a relaxed order with several heaps
+
+    start = std::chrono::steady_clock::now();
+    for (stdgpu::index_t i = 0; i < iterations; ++i)
+    {
+        thrust::for_each(thrust::counting_iterator<int>(0), thrust::counting_iterator<int>(batch),
+                         reschedule_queue(queue));
+    }
+    end = std::chrono::steady_clock::now();
+
+    seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "Priority queue       : " << static_cast<double>(iterations * batch) / seconds << " events per second" << std::endl;
+
+    destroyDeviceArray<int>(d_events);
+    stdgpu::priority_queue<int>::destroyDeviceObject(queue);
+}
@@ -0,0 +1,171 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/transform.h>
+
+#include <stdgpu/atomic.cuh>        // stdgpu::atomic
+#include <stdgpu/iterator.h>        // device_cbegin, device_cend
+#include <stdgpu/memory.h>          // createDeviceArray, destroyDeviceArray
+#include <stdgpu/platform.h>        // STDGPU_HOST_DEVICE
+#include <stdgpu/task_pool.cuh>     // stdgpu::task_pool
+
+
+
+// Irregular workload : Every fourth root spans a deep subtree while all other roots only span shallow ones
+struct root_depth
+{
+    STDGPU_HOST_DEVICE int
+    operator()(const int i) const
+    {
+        return (i % 4 == 0) ? 16 : 4;
+    }
+};
+
+
+STDGPU_HOST_DEVICE unsigned int
+process_node(const int depth)
+{
+    // Some artificial work per node
+    unsigned int h = static_cast<unsigned int>(depth);
+    for (int i = 0; i < 64; ++i)
+    {
+        h = h * 1664525u + 1013904223u;
+    }
+    return h;
+}
+
+
+struct traverse_subtree
+{
+    stdgpu::atomic<int> visited;
+    stdgpu::atomic<unsigned int> checksum;
+
+    traverse_subtree(stdgpu::atomic<int> visited,
+                     stdgpu::atomic<unsigned int> checksum)
+        : visited(visited),
+          checksum(checksum)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const int root_depth)
+    {
+        // Depth-first traversal of the whole subtree by a single thread
+        int stack[64];
+        int stack_size = 0;
+        int count = 0;
+        unsigned int sum = 0;
+
+        stack[stack_size++] = root_depth;
+        while (stack_size > 0)
+        {
+            int depth = stack[--stack_size];
+
+            sum += process_node(depth);
+            ++count;
+
+            if (depth > 0)
+            {
+                stack[stack_size++] = depth - 1;
+                stack[stack_size++] = depth - 1;
+            }
+        }
+
+        visited.fetch_add(count);
+        checksum.fetch_add(sum);
+    }
+};
+
+
+struct visit_node
+{
+    stdgpu::atomic<int> visited;
+    stdgpu::atomic<unsigned int> checksum;
+
+    visit_node(stdgpu::atomic<int> visited,
+               stdgpu::atomic<unsigned int> checksum)
+        : visited(visited),
+          checksum(checksum)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const int depth,
+               stdgpu::task_pool<int>& pool,
+               const stdgpu::index_t worker)
+    {
+        visited.fetch_add(1);
+        checksum.fetch_add(process_node(depth));
+
+        // Children are spawned as new tasks which idle workers can steal
+        if (depth > 0)
+        {
+            pool.push(worker, depth - 1);
+            pool.push(worker, depth - 1);
+        }
+    }
+};
+
+
+int
+main()
+{
+    const stdgpu::index_t n = 64;
+    const stdgpu::index_t workers = 8;
+
+    int* d_roots = createDeviceArray<int>(n);
+    stdgpu::atomic<int> visited = stdgpu::atomic<int>::createDeviceObject();
+    stdgpu::atomic<unsigned int> checksum = stdgpu::atomic<unsigned int>::createDeviceObject();
+    stdgpu::task_pool<int> pool = stdgpu::task_pool<int>::createDeviceObject(workers, 1 << 10);
+
+    thrust::transform(thrust::counting_iterator<int>(0), thrust::counting_iterator<int>(n),
+                      stdgpu::device_begin(d_roots),
+                      root_depth());
+
+    // Static partition : Every root is processed by one thread, so the threads with deep subtrees determine the runtime
+
+    visited.store(0);
+    checksum.store(0);
+
+    auto start = std::chrono::steady_clock::now();
+    thrust::for_each(stdgpu::device_cbegin(d_roots), stdgpu::device_cend(d_roots),
+                     traverse_subtree(visited, checksum));
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "Static partition : Visited " << visited.load() << " nodes (checksum " << checksum.load() << ") in " << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+
+    // Dynamic load balancing : The subtrees are split into tasks which are shared among the workers
+
+    visited.store(0);
+    checksum.store(0);
+
+    start = std::chrono::steady_clock::now();
+    pool.push(stdgpu::device_cbegin(d_roots), stdgpu::device_cend(d_roots));
+    pool.run(visit_node(visited, checksum));
+    end = std::chrono::steady_clock::now();
+
+    std::cout << "Work stealing    : Visited " << visited.load() << " nodes (checksum " << checksum.load() << ") in " << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+
+    destroyDeviceArray<int>(d_roots);
+    stdgpu::atomic<int>::destroyDeviceObject(visited);
+    stdgpu::atomic<unsigned int>::destroyDeviceObject(checksum);
+    stdgpu::task_pool<int>::destroyDeviceObject(pool);
+}
@@ -612,6 +612,16 @@ class atomic_ref
         T* _value = nullptr;
 };
 
+
+/**
+ * \brief Establishes an ordering of the memory accesses of the calling thread before and after the fence
+ *
+ * Differences to std::atomic_thread_fence:
+ *  - No memory order argument, the fence always orders all preceding and following memory accesses
+ */
+STDGPU_DEVICE_ONLY void
+atomic_thread_fence();
+
 } // namespace stdgpu
 
 
@@ -166,6 +166,32 @@ class bitset
         set(const index_t n,
             const bool value = true);
 
+        /**
+         * \brief Sets the bits in the given range of positions
+         * \param[in] first The first position that should be set
+         * \param[in] last The position after the last one that should be set
+         * \param[in] value The new value of the bits
+         * \pre 0 <= first <= last <= size()
+         * \note The bits are updated block by block rather than bit by bit
+         */
+        void
+        set_range(const index_t first,
+                  const index_t last,
+                  const bool value = true);
+
+        /**
+         * \brief Sets the bits in the given range of positions from the calling thread
+         * \param[in] first The first position that should be set
+         * \param[in] last The position after the last one that should be set
+         * \param[in] value The new value of the bits
+         * \pre 0 <= first <= last <= size()
+         * \note Unlike set_range(), the bits are updated by the calling thread itself with one atomic operation per block
+         */
+        STDGPU_DEVICE_ONLY void
+        set_bits(const index_t first,
+                 const index_t last,
+                 const bool value = true);
+
         /**
          * \brief Resets all bits
          * \post count() == 0
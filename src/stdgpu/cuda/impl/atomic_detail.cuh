@@ -127,6 +127,13 @@ atomic_fetch_dec_mod(T* address,
     return atomicDec(address, arg);
 }
 
+
+inline STDGPU_DEVICE_ONLY void
+atomic_thread_fence()
+{
+    __threadfence();
+}
+
 } // namespace cuda
 
 } // namespace stdgpu
@@ -0,0 +1,48 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_CUDA_MUTEX_DETAIL_H
+#define STDGPU_CUDA_MUTEX_DETAIL_H
+
+
+
+namespace stdgpu
+{
+
+namespace cuda
+{
+
+inline STDGPU_DEVICE_ONLY void
+backoff(const unsigned int nanoseconds)
+{
+    #if __CUDA_ARCH__ >= 700
+        __nanosleep(nanoseconds);
+    #else
+        // No sleep instruction available, so busy wait on the clock counter which roughly ticks once per nanosecond
+        const long long int start = clock64();
+        while (clock64() - start < static_cast<long long int>(nanoseconds))
+        {
+
+        }
+    #endif
+}
+
+} // namespace cuda
+
+} // namespace stdgpu
+
+
+
+#endif // STDGPU_CUDA_MUTEX_DETAIL_H
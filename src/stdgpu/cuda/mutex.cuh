@@ -0,0 +1,46 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_CUDA_MUTEX_H
+#define STDGPU_CUDA_MUTEX_H
+
+#include <stdgpu/platform.h>
+
+
+
+namespace stdgpu
+{
+
+namespace cuda
+{
+
+/**
+ * \brief Suspends the calling thread for approximately the given duration to reduce the contention on a lock
+ * \param[in] nanoseconds The approximate duration
+ */
+STDGPU_DEVICE_ONLY void
+backoff(const unsigned int nanoseconds);
+
+} // namespace cuda
+
+} // namespace stdgpu
+
+
+
+#include <stdgpu/cuda/impl/mutex_detail.cuh>
+
+
+
+#endif // STDGPU_CUDA_MUTEX_H
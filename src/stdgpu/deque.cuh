@@ -31,7 +31,6 @@
 #include <stdgpu/mutex.cuh>
 #include <stdgpu/platform.h>
 #include <stdgpu/ranges.h>
-#include <stdgpu/vector.cuh>
 
 
 
@@ -48,15 +47,6 @@
 namespace stdgpu
 {
 
-namespace detail
-{
-
-template <typename T>
-struct deque_collect_positions;
-
-} // namespace detail
-
-
 /**
  * \brief A generic container similar to std::deque on the GPU
  * \tparam T The type of the stored elements
@@ -228,6 +218,52 @@ class deque
         STDGPU_DEVICE_ONLY thrust::pair<T, bool>
         pop_front();
 
+        /**
+         * \brief Adds the given block of elements to the end of the object with a single reservation
+         * \param[in] elements The elements
+         * \param[in] n The number of elements
+         * \return True if the whole block fits into the object, false otherwise
+         * \pre n >= 0
+         * \note The block is either added completely and contiguously or not at all
+         */
+        STDGPU_DEVICE_ONLY bool
+        push_back_n(const T* elements,
+                    const index_t n);
+
+        /**
+         * \brief Removes up to n elements from the end of the object with a single reservation
+         * \param[out] elements The popped elements, starting with the last element of the object
+         * \param[in] n The maximum number of elements
+         * \return The number of popped elements
+         * \pre n >= 0
+         */
+        STDGPU_DEVICE_ONLY index_t
+        pop_back_n(T* elements,
+                   const index_t n);
+
+        /**
+         * \brief Adds the given block of elements to the front of the object with a single reservation
+         * \param[in] elements The elements
+         * \param[in] n The number of elements
+         * \return True if the whole block fits into the object, false otherwise
+         * \pre n >= 0
+         * \note The block is either added completely and contiguously in the given order or not at all
+         */
+        STDGPU_DEVICE_ONLY bool
+        push_front_n(const T* elements,
+                     const index_t n);
+
+        /**
+         * \brief Removes up to n elements from the front of the object with a single reservation
+         * \param[out] elements The popped elements, starting with the first element of the object
+         * \param[in] n The maximum number of elements
+         * \return The number of popped elements
+         * \pre n >= 0
+         */
+        STDGPU_DEVICE_ONLY index_t
+        pop_front_n(T* elements,
+                    const index_t n);
+
         /**
          * \brief Checks if the object is empty
          * \return True if the object is empty, false otherwise
@@ -300,26 +336,59 @@ class deque
 
         /**
          * \brief Creates a range of the device container
-         * \return A range of the object
+         * \return A range of the object consisting of at most two contiguous segments of the underlying array
          */
-        stdgpu::device_indexed_range<T>
+        stdgpu::device_ring_range<T>
         device_range();
 
         /**
          * \brief Creates a range of the device container
-         * \return A const range of the object
+         * \return A const range of the object consisting of at most two contiguous segments of the underlying array
          */
-        stdgpu::device_indexed_range<const T>
+        stdgpu::device_ring_range<const T>
         device_range() const;
 
     private:
 
-        template <typename T2>
-        friend class detail::deque_collect_positions;
-
         STDGPU_DEVICE_ONLY bool
         occupied(const index_t n) const;
 
+        using position_type = unsigned long long int;
+
+        STDGPU_HOST_DEVICE position_type
+        position_origin() const;
+
+        STDGPU_HOST_DEVICE index_t
+        wrap(const position_type position) const;
+
+        STDGPU_DEVICE_ONLY void
+        await_occupied(const position_type first,
+                       const index_t n,
+                       const bool value) const;
+
+        STDGPU_DEVICE_ONLY void
+        set_occupied(const position_type first,
+                     const index_t n,
+                     const bool value);
+
+        STDGPU_DEVICE_ONLY void
+        push_block(const position_type first,
+                   const T* elements,
+                   const index_t n);
+
+        STDGPU_DEVICE_ONLY void
+        pop_block(const position_type first,
+                  T* elements,
+                  const index_t n,
+                  const bool reversed);
+
+        STDGPU_DEVICE_ONLY bool
+        reserve_size(const index_t n);
+
+        STDGPU_DEVICE_ONLY index_t
+        release_size(const index_t n);
+
+
         bool
         occupied_count_valid() const;
 
@@ -330,11 +399,9 @@ class deque
         mutex_array _locks = {};
         bitset _occupied = {};
         atomic<int> _size = {};
-        atomic<unsigned int> _begin = {};
-        atomic<unsigned int> _end = {};
+        atomic<position_type> _begin = {};
+        atomic<position_type> _end = {};
         index_t _capacity = 0;
-
-        mutable vector<index_t> _range_indices = {};
 };
 
 } // namespace stdgpu
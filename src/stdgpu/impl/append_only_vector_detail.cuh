@@ -0,0 +1,313 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_APPEND_ONLY_VECTOR_DETAIL_H
+#define STDGPU_APPEND_ONLY_VECTOR_DETAIL_H
+
+#include <stdgpu/algorithm.h>
+#include <stdgpu/contract.h>
+#include <stdgpu/iterator.h>
+#include <stdgpu/memory.h>
+#include <stdgpu/utility.h>
+
+
+
+namespace stdgpu
+{
+
+template <typename T>
+append_only_vector<T>
+append_only_vector<T>::createDeviceObject(const index_t& capacity)
+{
+    STDGPU_EXPECTS(capacity > 0);
+
+    append_only_vector<T> result;
+    allocator_type a;   // Will be replaced by member
+    result._data     = allocator_traits<allocator_type>::allocate(a, capacity);
+    result._size     = atomic<int>::createDeviceObject();
+    result._capacity = capacity;
+
+    return result;
+}
+
+template <typename T>
+void
+append_only_vector<T>::destroyDeviceObject(append_only_vector<T>& device_object)
+{
+    device_object.clear();
+
+    allocator_type a = device_object.get_allocator();   // Will be replaced by member
+    allocator_traits<allocator_type>::deallocate(a, device_object._data, device_object._capacity);
+    atomic<int>::destroyDeviceObject(device_object._size);
+    device_object._capacity = 0;
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE typename append_only_vector<T>::allocator_type
+append_only_vector<T>::get_allocator() const
+{
+    return allocator_type();
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY typename append_only_vector<T>::reference
+append_only_vector<T>::at(const append_only_vector<T>::index_type n)
+{
+    return const_cast<append_only_vector<T>::reference>(static_cast<const append_only_vector<T>*>(this)->at(n));
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY typename append_only_vector<T>::const_reference
+append_only_vector<T>::at(const append_only_vector<T>::index_type n) const
+{
+    STDGPU_EXPECTS(0 <= n);
+    STDGPU_EXPECTS(n < size());
+
+    return _data[n];
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY typename append_only_vector<T>::reference
+append_only_vector<T>::operator[](const append_only_vector<T>::index_type n)
+{
+    return at(n);
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY typename append_only_vector<T>::const_reference
+append_only_vector<T>::operator[](const append_only_vector<T>::index_type n) const
+{
+    return at(n);
+}
+
+
+template <typename T>
+template <class... Args>
+inline STDGPU_DEVICE_ONLY bool
+append_only_vector<T>::emplace_back(Args&&... args)
+{
+    return push_back(T(forward<Args>(args)...));
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY bool
+append_only_vector<T>::push_back(const T& element)
+{
+    int push_position = _size++;
+
+    if (push_position >= _capacity)
+    {
+        // Revert the reservation, such that the size settles at the capacity once all failing calls have returned
+        --_size;
+
+        printf("stdgpu::append_only_vector::push_back : Object full\n");
+        return false;
+    }
+
+    allocator_type a = get_allocator();     // Will be replaced by member
+    allocator_traits<allocator_type>::construct(a, &(_data[push_position]), element);
+
+    return true;
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY thrust::pair<index_t, bool>
+append_only_vector<T>::push_back_n(const T* elements,
+                                   const index_t n)
+{
+    STDGPU_EXPECTS(n >= 0);
+
+    // Reserve the whole block with a single atomic addition such that the block is contiguous
+    int push_position = _size.fetch_add(static_cast<int>(n));
+
+    if (push_position + n > _capacity)
+    {
+        // Revert the reservation, such that the size settles at the capacity once all failing calls have returned
+        _size.fetch_sub(static_cast<int>(n));
+
+        printf("stdgpu::append_only_vector::push_back_n : Not enough space left for %d elements\n", static_cast<int>(n));
+        return thrust::make_pair(stdgpu::min<index_t>(push_position, _capacity), false);
+    }
+
+    allocator_type a = get_allocator();     // Will be replaced by member
+    for (index_t i = 0; i < n; ++i)
+    {
+        allocator_traits<allocator_type>::construct(a, &(_data[push_position + i]), elements[i]);
+    }
+
+    return thrust::make_pair(static_cast<index_t>(push_position), true);
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE bool
+append_only_vector<T>::empty() const
+{
+    return (size() == 0);
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE bool
+append_only_vector<T>::full() const
+{
+    return (size() == max_size());
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE index_t
+append_only_vector<T>::size() const
+{
+    index_t current_size = _size.load();
+
+    // Failing push_back calls may temporarily exceed the capacity before reverting their reservation
+    return stdgpu::min<index_t>(current_size, _capacity);
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE index_t
+append_only_vector<T>::max_size() const
+{
+    return capacity();
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE index_t
+append_only_vector<T>::capacity() const
+{
+    return _capacity;
+}
+
+
+template <typename T>
+inline const T*
+append_only_vector<T>::data() const
+{
+    return _data;
+}
+
+
+template <typename T>
+inline T*
+append_only_vector<T>::data()
+{
+    return _data;
+}
+
+
+template <typename T>
+inline void
+append_only_vector<T>::clear()
+{
+    if (empty()) return;
+
+    const index_t current_size = size();
+
+    stdgpu::destroy(stdgpu::device_begin(_data), stdgpu::device_begin(_data) + current_size);
+
+    _size.store(0);
+
+    STDGPU_ENSURES(empty());
+    STDGPU_ENSURES(valid());
+}
+
+
+template <typename T>
+inline bool
+append_only_vector<T>::valid() const
+{
+    int current_size = _size.load();
+    return (0 <= current_size && current_size <= static_cast<int>(_capacity));
+}
+
+
+template <typename T>
+device_ptr<T>
+append_only_vector<T>::device_begin()
+{
+    return stdgpu::device_begin(_data);
+}
+
+
+template <typename T>
+device_ptr<T>
+append_only_vector<T>::device_end()
+{
+    return device_begin() + size();
+}
+
+
+template <typename T>
+device_ptr<const T>
+append_only_vector<T>::device_begin() const
+{
+    return stdgpu::device_begin(_data);
+}
+
+
+template <typename T>
+device_ptr<const T>
+append_only_vector<T>::device_end() const
+{
+    return device_begin() + size();
+}
+
+
+template <typename T>
+device_ptr<const T>
+append_only_vector<T>::device_cbegin() const
+{
+    return stdgpu::device_cbegin(_data);
+}
+
+
+template <typename T>
+device_ptr<const T>
+append_only_vector<T>::device_cend() const
+{
+    return device_cbegin() + size();
+}
+
+
+template <typename T>
+stdgpu::device_range<T>
+append_only_vector<T>::device_range()
+{
+    return stdgpu::device_range<T>(_data, size());
+}
+
+
+template <typename T>
+stdgpu::device_range<const T>
+append_only_vector<T>::device_range() const
+{
+    return stdgpu::device_range<const T>(_data, size());
+}
+
+} // namespace stdgpu
+
+
+
+#endif // STDGPU_APPEND_ONLY_VECTOR_DETAIL_H
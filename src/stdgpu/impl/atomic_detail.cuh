@@ -556,6 +556,13 @@ atomic_ref<T>::operator^=(const T arg)
     return fetch_xor(arg) ^ arg;
 }
 
+
+inline STDGPU_DEVICE_ONLY void
+atomic_thread_fence()
+{
+    stdgpu::STDGPU_BACKEND_NAMESPACE::atomic_thread_fence();
+}
+
 } // namespace stdgpu
 
 
@@ -16,6 +16,7 @@
 #ifndef STDGPU_BITSET_DETAIL_H
 #define STDGPU_BITSET_DETAIL_H
 
+#include <stdgpu/algorithm.h>
 #include <stdgpu/atomic.cuh>
 #include <stdgpu/contract.h>
 #include <stdgpu/cstdlib.h>
@@ -112,6 +113,56 @@ bitset::set(const index_t n,
 }
 
 
+namespace detail
+{
+
+template <typename T>
+inline STDGPU_HOST_DEVICE T
+bit_block_range_pattern(const index_t block,
+                        const index_t bits_per_block,
+                        const index_t first,
+                        const index_t last)
+{
+    const index_t block_begin = block * bits_per_block;
+    const index_t lower = stdgpu::max<index_t>(first, block_begin) - block_begin;
+    const index_t upper = stdgpu::min<index_t>(last, block_begin + bits_per_block) - block_begin;
+
+    return (upper - lower == bits_per_block)
+         ? numeric_limits<T>::max()
+         : static_cast<T>(((static_cast<T>(1) << (upper - lower)) - 1) << lower);
+}
+
+} // namespace detail
+
+
+inline STDGPU_DEVICE_ONLY void
+bitset::set_bits(const index_t first,
+                 const index_t last,
+                 const bool value)
+{
+    STDGPU_EXPECTS(0 <= first);
+    STDGPU_EXPECTS(first <= last);
+    STDGPU_EXPECTS(last <= size());
+
+    if (first == last) return;
+
+    for (index_t block = first / _bits_per_block; block <= (last - 1) / _bits_per_block; ++block)
+    {
+        const block_type pattern = detail::bit_block_range_pattern<block_type>(block, _bits_per_block, first, last);
+
+        stdgpu::atomic_ref<block_type> bit_block(_bit_blocks[block]);
+        if (value)
+        {
+            bit_block.fetch_or(pattern);
+        }
+        else
+        {
+            bit_block.fetch_and(numeric_limits<block_type>::max() - pattern);
+        }
+    }
+}
+
+
 inline STDGPU_DEVICE_ONLY bool
 bitset::reset(const index_t n)
 {
@@ -16,9 +16,8 @@
 #ifndef STDGPU_DEQUE_DETAIL_H
 #define STDGPU_DEQUE_DETAIL_H
 
-#include <thrust/for_each.h>
-#include <thrust/iterator/counting_iterator.h>
 
+#include <stdgpu/algorithm.h>
 #include <stdgpu/contract.h>
 #include <stdgpu/iterator.h>
 #include <stdgpu/memory.h>
@@ -41,11 +40,12 @@ deque<T>::createDeviceObject(const index_t& capacity)
     result._locks    = mutex_array::createDeviceObject(capacity);
     result._occupied = bitset::createDeviceObject(capacity);
     result._size     = atomic<int>::createDeviceObject();
-    result._begin    = atomic<unsigned int>::createDeviceObject();
-    result._end      = atomic<unsigned int>::createDeviceObject();
+    result._begin    = atomic<position_type>::createDeviceObject();
+    result._end      = atomic<position_type>::createDeviceObject();
     result._capacity = capacity;
 
-    result._range_indices = vector<index_t>::createDeviceObject(capacity);
+    result._begin.store(result.position_origin());
+    result._end.store(result.position_origin());
 
     return result;
 }
@@ -61,11 +61,9 @@ deque<T>::destroyDeviceObject(deque<T>& device_object)
     mutex_array::destroyDeviceObject(device_object._locks);
     bitset::destroyDeviceObject(device_object._occupied);
     atomic<int>::destroyDeviceObject(device_object._size);
-    atomic<unsigned int>::destroyDeviceObject(device_object._begin);
-    atomic<unsigned int>::destroyDeviceObject(device_object._end);
+    atomic<position_type>::destroyDeviceObject(device_object._begin);
+    atomic<position_type>::destroyDeviceObject(device_object._end);
     device_object._capacity = 0;
-
-    vector<index_t>::destroyDeviceObject(device_object._range_indices);
 }
 
 
@@ -91,13 +89,12 @@ deque<T>::at(const deque<T>::index_type n) const
 {
     STDGPU_EXPECTS(0 <= n);
     STDGPU_EXPECTS(n < size());
-    STDGPU_EXPECTS(occupied(n));
 
-    index_t index_to_wrap = _begin.load() + n;
+    const index_t position = wrap(_begin.load() + static_cast<position_type>(n));
 
-    STDGPU_ASSERT(0 <= index_to_wrap);
+    STDGPU_ASSERT(occupied(position));
 
-    return _data[index_to_wrap % _capacity];
+    return _data[position];
 }
 
 
@@ -176,7 +173,7 @@ deque<T>::push_back(const T& element)
     // Check size
     if (current_size < _capacity)
     {
-        unsigned int push_position = _end.fetch_inc_mod(_capacity);
+        index_t push_position = wrap(_end.fetch_add(1));
 
         while (!pushed)
         {
@@ -188,6 +185,9 @@ deque<T>::push_back(const T& element)
                 {
                     allocator_type a = get_allocator();     // Will be replaced by member
                     allocator_traits<allocator_type>::construct(a, &(_data[push_position]), element);
+
+                    // The batch removals do not take the lock, so the element must be visible before the position is marked as occupied
+                    atomic_thread_fence();
                     bool was_occupied = _occupied.set(push_position);
                     pushed = true;
 
@@ -230,8 +230,7 @@ deque<T>::pop_back()
     // Check size
     if (current_size > 0)
     {
-        unsigned int pop_position = _end.fetch_dec_mod(_capacity);
-        pop_position = (pop_position == 0) ? _capacity - 1 : pop_position - 1;  // Manually reconstruct stored value
+        index_t pop_position = wrap(_end.fetch_sub(1) - 1);
 
         while (!popped.second)
         {
@@ -241,11 +240,14 @@ deque<T>::pop_back()
 
                 if (occupied(pop_position))
                 {
-                    bool was_occupied = _occupied.reset(pop_position);
                     allocator_type a = get_allocator();     // Will be replaced by member
                     allocator_traits<allocator_type>::construct(a, &popped, _data[pop_position], true);
                     allocator_traits<allocator_type>::destroy(a, &(_data[pop_position]));
 
+                    // The batch insertions do not take the lock, so the position must only be released after the element is gone
+                    atomic_thread_fence();
+                    bool was_occupied = _occupied.reset(pop_position);
+
                     if (!was_occupied)
                     {
                         printf("stdgpu::deque::pop_back : Expected entry to be occupied but actually was not\n");
@@ -293,8 +295,7 @@ deque<T>::push_front(const T& element)
     // Check size
     if (current_size < _capacity)
     {
-        unsigned int push_position = _begin.fetch_dec_mod(_capacity);
-        push_position = (push_position == 0) ? _capacity - 1 : push_position - 1;  // Manually reconstruct stored value
+        index_t push_position = wrap(_begin.fetch_sub(1) - 1);
 
         while (!pushed)
         {
@@ -306,6 +307,9 @@ deque<T>::push_front(const T& element)
                 {
                     allocator_type a = get_allocator();     // Will be replaced by member
                     allocator_traits<allocator_type>::construct(a, &(_data[push_position]), element);
+
+                    // The batch removals do not take the lock, so the element must be visible before the position is marked as occupied
+                    atomic_thread_fence();
                     bool was_occupied = _occupied.set(push_position);
                     pushed = true;
 
@@ -348,7 +352,7 @@ deque<T>::pop_front()
     // Check size
     if (current_size > 0)
     {
-        unsigned int pop_position = _begin.fetch_inc_mod(_capacity);
+        index_t pop_position = wrap(_begin.fetch_add(1));
 
         while (!popped.second)
         {
@@ -358,11 +362,14 @@ deque<T>::pop_front()
 
                 if (occupied(pop_position))
                 {
-                    bool was_occupied = _occupied.reset(pop_position);
                     allocator_type a = get_allocator();     // Will be replaced by member
                     allocator_traits<allocator_type>::construct(a, &popped, _data[pop_position], true);
                     allocator_traits<allocator_type>::destroy(a, &(_data[pop_position]));
 
+                    // The batch insertions do not take the lock, so the position must only be released after the element is gone
+                    atomic_thread_fence();
+                    bool was_occupied = _occupied.reset(pop_position);
+
                     if (!was_occupied)
                     {
                         printf("stdgpu::deque::pop_front : Expected entry to be occupied but actually was not\n");
@@ -383,6 +390,86 @@ deque<T>::pop_front()
 }
 
 
+template <typename T>
+inline STDGPU_DEVICE_ONLY bool
+deque<T>::push_back_n(const T* elements,
+                      const index_t n)
+{
+    STDGPU_EXPECTS(n >= 0);
+
+    if (n == 0) return true;
+
+    if (!reserve_size(n))
+    {
+        printf("stdgpu::deque::push_back_n : Not enough space left for %d elements\n", static_cast<int>(n));
+        return false;
+    }
+
+    // A single atomic operation claims the whole block of positions
+    push_block(_end.fetch_add(static_cast<position_type>(n)), elements, n);
+
+    return true;
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY index_t
+deque<T>::pop_back_n(T* elements,
+                     const index_t n)
+{
+    STDGPU_EXPECTS(n >= 0);
+
+    index_t popped_count = release_size(n);
+
+    if (popped_count == 0) return 0;
+
+    const position_type first = _end.fetch_sub(static_cast<position_type>(popped_count)) - static_cast<position_type>(popped_count);
+
+    // Start with the last element
+    pop_block(first, elements, popped_count, true);
+
+    return popped_count;
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY bool
+deque<T>::push_front_n(const T* elements,
+                       const index_t n)
+{
+    STDGPU_EXPECTS(n >= 0);
+
+    if (n == 0) return true;
+
+    if (!reserve_size(n))
+    {
+        printf("stdgpu::deque::push_front_n : Not enough space left for %d elements\n", static_cast<int>(n));
+        return false;
+    }
+
+    push_block(_begin.fetch_sub(static_cast<position_type>(n)) - static_cast<position_type>(n), elements, n);
+
+    return true;
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY index_t
+deque<T>::pop_front_n(T* elements,
+                      const index_t n)
+{
+    STDGPU_EXPECTS(n >= 0);
+
+    index_t popped_count = release_size(n);
+
+    if (popped_count == 0) return 0;
+
+    pop_block(_begin.fetch_add(static_cast<position_type>(popped_count)), elements, popped_count, false);
+
+    return popped_count;
+}
+
+
 template <typename T>
 inline STDGPU_HOST_DEVICE bool
 deque<T>::empty() const
@@ -468,8 +555,8 @@ deque<T>::clear()
 {
     if (empty()) return;
 
-    const index_t begin = _begin.load();
-    const index_t end = _end.load();
+    const index_t begin = wrap(_begin.load());
+    const index_t end = wrap(_end.load());
 
     // One large block
     if (begin <= end)
@@ -488,8 +575,8 @@ deque<T>::clear()
 
     _size.store(0);
 
-    _begin.store(0);
-    _end.store(0);
+    _begin.store(position_origin());
+    _end.store(position_origin());
 
     STDGPU_ENSURES(empty());
     STDGPU_ENSURES(valid());
@@ -509,64 +596,159 @@ deque<T>::valid() const
          && _locks.valid());
 }
 
-namespace detail
+template <typename T>
+stdgpu::device_ring_range<T>
+deque<T>::device_range()
+{
+    return device_ring_range<value_type>(data(), capacity(), wrap(_begin.load()), size());
+}
+
+
+template <typename T>
+stdgpu::device_ring_range<const T>
+deque<T>::device_range() const
 {
+    return device_ring_range<const value_type>(data(), capacity(), wrap(_begin.load()), size());
+}
+
 
 template <typename T>
-struct deque_collect_positions
+inline STDGPU_DEVICE_ONLY bool
+deque<T>::occupied(const index_t n) const
 {
-    deque<T> d;
+    return _occupied[n];
+}
 
-    deque_collect_positions(const deque<T>& d)
-        : d(d)
-    {
 
-    }
+template <typename T>
+inline STDGPU_HOST_DEVICE typename deque<T>::position_type
+deque<T>::position_origin() const
+{
+    // Start in the middle of the range at a multiple of the capacity, such that the positions never wrap around in practice
+    const position_type middle = static_cast<position_type>(1) << 63;
+    return middle - middle % static_cast<position_type>(_capacity);
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE index_t
+deque<T>::wrap(const position_type position) const
+{
+    return static_cast<index_t>(position % static_cast<position_type>(_capacity));
+}
 
-    STDGPU_DEVICE_ONLY void
-    operator()(const index_t i)
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY void
+deque<T>::await_occupied(const position_type first,
+                         const index_t n,
+                         const bool value) const
+{
+    for (index_t i = 0; i < n; ++i)
     {
-        if (d.occupied(i))
+        const index_t position = wrap(first + static_cast<position_type>(i));
+
+        // The fence also forces the bit to be reloaded in every iteration
+        while (occupied(position) != value)
         {
-            d._range_indices.push_back(i);
+            atomic_thread_fence();
         }
     }
-};
 
-} // namespace detail
+    atomic_thread_fence();
+}
 
 
 template <typename T>
-stdgpu::device_indexed_range<T>
-deque<T>::device_range()
+inline STDGPU_DEVICE_ONLY void
+deque<T>::set_occupied(const position_type first,
+                       const index_t n,
+                       const bool value)
+{
+    const index_t begin = wrap(first);
+    const index_t first_count = stdgpu::min<index_t>(n, _capacity - begin);
+
+    // The block consists of at most two contiguous segments
+    _occupied.set_bits(begin, begin + first_count, value);
+    _occupied.set_bits(0, n - first_count, value);
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY void
+deque<T>::push_block(const position_type first,
+                     const T* elements,
+                     const index_t n)
 {
-    _range_indices.clear();
+    // The claimed positions are owned exclusively once the removals of the previous round have released them
+    await_occupied(first, n, false);
 
-    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(size()),
-                     detail::deque_collect_positions<T>(*this));
+    allocator_type a = get_allocator();     // Will be replaced by member
+    for (index_t i = 0; i < n; ++i)
+    {
+        allocator_traits<allocator_type>::construct(a, &(_data[wrap(first + static_cast<position_type>(i))]), elements[i]);
+    }
 
-    return device_indexed_range<value_type>(_range_indices.device_range(), data());
+    atomic_thread_fence();
+    set_occupied(first, n, true);
 }
 
 
 template <typename T>
-stdgpu::device_indexed_range<const T>
-deque<T>::device_range() const
+inline STDGPU_DEVICE_ONLY void
+deque<T>::pop_block(const position_type first,
+                    T* elements,
+                    const index_t n,
+                    const bool reversed)
 {
-    _range_indices.clear();
+    // The claimed positions are owned exclusively once the insertions of this round have finished
+    await_occupied(first, n, true);
+
+    allocator_type a = get_allocator();     // Will be replaced by member
+    for (index_t i = 0; i < n; ++i)
+    {
+        const index_t position = wrap(first + static_cast<position_type>(i));
 
-    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(size()),
-                     detail::deque_collect_positions<T>(*this));
+        elements[reversed ? n - 1 - i : i] = stdgpu::move(_data[position]);
+        allocator_traits<allocator_type>::destroy(a, &(_data[position]));
+    }
 
-    return device_indexed_range<const value_type>(_range_indices.device_range(), data());
+    atomic_thread_fence();
+    set_occupied(first, n, false);
 }
 
 
 template <typename T>
 inline STDGPU_DEVICE_ONLY bool
-deque<T>::occupied(const index_t n) const
+deque<T>::reserve_size(const index_t n)
 {
-    return _occupied[n];
+    int current_size = _size.load();
+    do
+    {
+        if (current_size + n > _capacity)
+        {
+            return false;
+        }
+    }
+    while (!_size.compare_exchange_weak(current_size, current_size + static_cast<int>(n)));
+
+    return true;
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY index_t
+deque<T>::release_size(const index_t n)
+{
+    int current_size = _size.load();
+    int released_size;
+    do
+    {
+        released_size = stdgpu::max<int>(0, stdgpu::min<int>(current_size, static_cast<int>(n)));
+    }
+    while (released_size > 0 && !_size.compare_exchange_weak(current_size, current_size - released_size));
+
+    return static_cast<index_t>(released_size);
 }
 
 
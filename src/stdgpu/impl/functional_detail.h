@@ -76,6 +76,27 @@ hash<E>::operator()(const E& key) const
     return hash<std::underlying_type_t<E>>()(static_cast<std::underlying_type_t<E>>(key));
 }
 
+
+namespace detail
+{
+
+inline STDGPU_HOST_DEVICE unsigned long long
+mix_hash(const std::size_t hash)
+{
+    // MurmurHash3 finalizer
+    unsigned long long h = static_cast<unsigned long long>(hash);
+
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdllu;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53llu;
+    h ^= h >> 33;
+
+    return h;
+}
+
+} // namespace detail
+
 } // namespace stdgpu
 
 
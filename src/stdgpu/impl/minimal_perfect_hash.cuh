@@ -0,0 +1,139 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_MINIMAL_PERFECT_HASH_H
+#define STDGPU_MINIMAL_PERFECT_HASH_H
+
+#include <cstddef>
+
+#include <stdgpu/cstddef.h>
+#include <stdgpu/platform.h>
+
+
+
+namespace stdgpu
+{
+
+namespace detail
+{
+
+/**
+ * \brief A minimal perfect hash function over a fixed set of keys built in parallel with a cascade of collision-free bit arrays (BBHash)
+ * \tparam Key The key type
+ * \tparam Hash The type of the hash functor
+ * \tparam KeyEqual The type of the key equality functor
+ *
+ * Every key of the set is mapped to a unique index in [0, size()). Keys are hashed into the bit array of each level until a bit is set.
+ * The position of that bit among all set bits (its rank) is the resulting index. Keys outside the set are mapped to an arbitrary index
+ * or size(), so callers need to compare the stored key.
+ *
+ * Distinct keys with the same hash value collide on every level and are never placed. They are kept in a small fallback array, which
+ * is searched linearly and mapped to the indices following the placed keys. Only keys that miss all levels pay for this search.
+ */
+template <typename Key,
+          typename Hash,
+          typename KeyEqual>
+class minimal_perfect_hash
+{
+    public:
+        using key_type          = Key;                                      /**< Key */
+        using hasher            = Hash;                                     /**< Hash */
+        using key_equal         = KeyEqual;                                 /**< KeyEqual */
+        using block_type        = unsigned int;                             /**< unsigned int */
+
+        static constexpr index_t max_levels = 32;                           /**< The maximum number of levels */
+
+        /**
+         * \brief Creates an object of this class on the GPU (device)
+         * \param[in] keys The device array of unique keys
+         * \param[in] n The number of keys
+         * \param[in] gamma The ratio of the number of bits to the number of remaining keys of each level
+         * \pre n >= 0
+         * \pre gamma >= 1
+         * \return A newly created object of this class allocated on the GPU (device)
+         */
+        static minimal_perfect_hash
+        createDeviceObject(const Key* keys,
+                           const index_t n,
+                           const float gamma = 2.0f);
+
+        /**
+         * \brief Destroys the given object of this class on the GPU (device)
+         * \param[in] device_object The object allocated on the GPU (device)
+         */
+        static void
+        destroyDeviceObject(minimal_perfect_hash& device_object);
+
+
+        /**
+         * \brief Empty constructor
+         */
+        minimal_perfect_hash() = default;
+
+
+        /**
+         * \brief Computes the index of the given key
+         * \param[in] key The key
+         * \return The unique index of the key if it is contained in the key set, an arbitrary index or size() otherwise
+         * \post result <= size()
+         */
+        STDGPU_DEVICE_ONLY index_t
+        operator()(const key_type& key) const;
+
+
+        /**
+         * \brief The number of keys, i.e. the size of the index range
+         * \return The number of keys
+         */
+        STDGPU_HOST_DEVICE index_t
+        size() const;
+
+
+        STDGPU_HOST_DEVICE std::size_t
+        level_hash(const key_type& key,
+                   const index_t level) const;
+
+        STDGPU_HOST_DEVICE index_t
+        level_bits(const index_t level) const;
+
+        STDGPU_DEVICE_ONLY bool
+        test(const index_t bit) const;
+
+        STDGPU_DEVICE_ONLY index_t
+        rank(const index_t bit) const;
+
+
+        index_t _size = 0;                                  /**< The number of keys */
+        index_t _level_count = 0;                           /**< The number of levels */
+        index_t _level_offsets[max_levels + 1] = {};        /**< The first bit of each level and the total number of bits */
+        block_type* _bits = nullptr;                        /**< The bit arrays of all levels */
+        index_t* _ranks = nullptr;                          /**< The number of set bits before each block */
+        index_t _fallback_count = 0;                        /**< The number of keys that could not be placed in any level */
+        Key* _fallback_keys = nullptr;                      /**< The keys that could not be placed in any level */
+        hasher _hash = {};                                  /**< The hashing function */
+        key_equal _key_equal = {};                          /**< The key comparison functor */
+};
+
+} // namespace detail
+
+} // namespace stdgpu
+
+
+
+#include <stdgpu/impl/minimal_perfect_hash_detail.cuh>
+
+
+
+#endif // STDGPU_MINIMAL_PERFECT_HASH_H
@@ -0,0 +1,383 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_MINIMAL_PERFECT_HASH_DETAIL_H
+#define STDGPU_MINIMAL_PERFECT_HASH_DETAIL_H
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <thrust/copy.h>
+#include <thrust/for_each.h>
+#include <thrust/gather.h>
+#include <thrust/scan.h>
+#include <thrust/sequence.h>
+#include <thrust/transform.h>
+
+#include <stdgpu/atomic.cuh>
+#include <stdgpu/bit.h>
+#include <stdgpu/contract.h>
+#include <stdgpu/functional.h>
+#include <stdgpu/iterator.h>
+#include <stdgpu/memory.h>
+
+
+
+namespace stdgpu
+{
+
+namespace detail
+{
+
+template <typename Key, typename Hash, typename KeyEqual>
+constexpr index_t minimal_perfect_hash<Key, Hash, KeyEqual>::max_levels;
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE std::size_t
+minimal_perfect_hash<Key, Hash, KeyEqual>::level_hash(const key_type& key,
+                                            const index_t level) const
+{
+    // Derive an independent hash for each level by seeding and mixing the user-provided hash
+    std::size_t seed = static_cast<std::size_t>(static_cast<unsigned long long>(level + 1) * 11400714819323198485llu);
+
+    return static_cast<std::size_t>(mix_hash(_hash(key) ^ seed));
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+minimal_perfect_hash<Key, Hash, KeyEqual>::level_bits(const index_t level) const
+{
+    STDGPU_EXPECTS(0 <= level);
+    STDGPU_EXPECTS(level < _level_count);
+
+    return _level_offsets[level + 1] - _level_offsets[level];
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY bool
+minimal_perfect_hash<Key, Hash, KeyEqual>::test(const index_t bit) const
+{
+    const index_t bits_per_block = std::numeric_limits<block_type>::digits;
+
+    return (_bits[bit / bits_per_block] & (static_cast<block_type>(1) << (bit % bits_per_block))) != 0;
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY index_t
+minimal_perfect_hash<Key, Hash, KeyEqual>::rank(const index_t bit) const
+{
+    const index_t bits_per_block = std::numeric_limits<block_type>::digits;
+
+    block_type lower_bits_mask = (static_cast<block_type>(1) << (bit % bits_per_block)) - static_cast<block_type>(1);
+
+    return _ranks[bit / bits_per_block] + static_cast<index_t>(popcount<block_type>(_bits[bit / bits_per_block] & lower_bits_mask));
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY index_t
+minimal_perfect_hash<Key, Hash, KeyEqual>::operator()(const key_type& key) const
+{
+    for (index_t level = 0; level < _level_count; ++level)
+    {
+        index_t bit = _level_offsets[level] + static_cast<index_t>(level_hash(key, level) % static_cast<std::size_t>(level_bits(level)));
+
+        if (test(bit))
+        {
+            index_t result = rank(bit);
+
+            STDGPU_ENSURES(result < size());
+            return result;
+        }
+    }
+
+    for (index_t i = 0; i < _fallback_count; ++i)
+    {
+        if (_key_equal(_fallback_keys[i], key))
+        {
+            return size() - _fallback_count + i;
+        }
+    }
+
+    return size();
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+minimal_perfect_hash<Key, Hash, KeyEqual>::size() const
+{
+    return _size;
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+struct count_level_hits
+{
+    minimal_perfect_hash<Key, Hash, KeyEqual> hash;
+    const Key* keys;
+    int* hits;
+    index_t level;
+    index_t bits;
+
+    count_level_hits(const minimal_perfect_hash<Key, Hash, KeyEqual>& hash,
+                     const Key* keys,
+                     int* hits,
+                     const index_t level,
+                     const index_t bits)
+        : hash(hash),
+          keys(keys),
+          hits(hits),
+          level(level),
+          bits(bits)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        index_t position = static_cast<index_t>(hash.level_hash(keys[i], level) % static_cast<std::size_t>(bits));
+
+        stdgpu::atomic_ref<int>(hits[position]).fetch_add(1);
+    }
+};
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+struct set_level_bits
+{
+    minimal_perfect_hash<Key, Hash, KeyEqual> hash;
+    const Key* keys;
+    const int* hits;
+    unsigned int* blocks;
+    index_t level;
+    index_t bits;
+
+    set_level_bits(const minimal_perfect_hash<Key, Hash, KeyEqual>& hash,
+                   const Key* keys,
+                   const int* hits,
+                   unsigned int* blocks,
+                   const index_t level,
+                   const index_t bits)
+        : hash(hash),
+          keys(keys),
+          hits(hits),
+          blocks(blocks),
+          level(level),
+          bits(bits)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        const index_t bits_per_block = std::numeric_limits<unsigned int>::digits;
+
+        index_t position = static_cast<index_t>(hash.level_hash(keys[i], level) % static_cast<std::size_t>(bits));
+
+        if (hits[position] == 1)
+        {
+            stdgpu::atomic_ref<unsigned int>(blocks[position / bits_per_block]).fetch_or(1u << (position % bits_per_block));
+        }
+    }
+};
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+struct level_collided
+{
+    minimal_perfect_hash<Key, Hash, KeyEqual> hash;
+    const Key* keys;
+    const int* hits;
+    index_t level;
+    index_t bits;
+
+    level_collided(const minimal_perfect_hash<Key, Hash, KeyEqual>& hash,
+                   const Key* keys,
+                   const int* hits,
+                   const index_t level,
+                   const index_t bits)
+        : hash(hash),
+          keys(keys),
+          hits(hits),
+          level(level),
+          bits(bits)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY bool
+    operator()(const index_t i) const
+    {
+        index_t position = static_cast<index_t>(hash.level_hash(keys[i], level) % static_cast<std::size_t>(bits));
+
+        return hits[position] != 1;
+    }
+};
+
+
+struct count_block_bits
+{
+    STDGPU_HOST_DEVICE index_t
+    operator()(const unsigned int block) const
+    {
+        return static_cast<index_t>(popcount<unsigned int>(block));
+    }
+};
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+minimal_perfect_hash<Key, Hash, KeyEqual>
+minimal_perfect_hash<Key, Hash, KeyEqual>::createDeviceObject(const Key* keys,
+                                                    const index_t n,
+                                                    const float gamma)
+{
+    STDGPU_EXPECTS(n >= 0);
+    STDGPU_EXPECTS(gamma >= 1.0f);
+
+    const index_t bits_per_block = std::numeric_limits<block_type>::digits;
+
+    minimal_perfect_hash<Key, Hash, KeyEqual> result;
+    result._hash        = hasher();
+    result._key_equal   = key_equal();
+
+    if (n == 0)
+    {
+        return result;
+    }
+
+
+    index_t* remaining          = createDeviceArray<index_t>(n);
+    index_t* next_remaining     = createDeviceArray<index_t>(n);
+    index_t remaining_count     = n;
+
+    thrust::sequence(device_begin(remaining), device_end(remaining));
+
+    std::vector<block_type*> level_blocks;
+
+    while (remaining_count > 0 && result._level_count < max_levels)
+    {
+        index_t level = result._level_count;
+
+        // Round up to whole blocks such that every level starts at a block boundary
+        index_t bits = static_cast<index_t>(std::ceil(gamma * static_cast<float>(remaining_count)));
+        bits = ((bits + bits_per_block - 1) / bits_per_block) * bits_per_block;
+
+        result._level_offsets[level + 1] = result._level_offsets[level] + bits;
+        result._level_count++;
+
+        int* hits = createDeviceArray<int>(bits, 0);
+        block_type* blocks = createDeviceArray<block_type>(bits / bits_per_block, 0);
+
+        thrust::for_each(make_device(remaining), make_device(remaining) + remaining_count,
+                         count_level_hits<Key, Hash, KeyEqual>(result, keys, hits, level, bits));
+
+        thrust::for_each(make_device(remaining), make_device(remaining) + remaining_count,
+                         set_level_bits<Key, Hash, KeyEqual>(result, keys, hits, blocks, level, bits));
+
+        remaining_count = static_cast<index_t>(thrust::copy_if(make_device(remaining), make_device(remaining) + remaining_count,
+                                                               make_device(next_remaining),
+                                                               level_collided<Key, Hash, KeyEqual>(result, keys, hits, level, bits))
+                                             - make_device(next_remaining));
+
+        std::swap(remaining, next_remaining);
+
+        level_blocks.push_back(blocks);
+        destroyDeviceArray<int>(hits);
+    }
+
+    // Keys with equal hash values collide on every level, so store them separately behind the placed keys
+    if (remaining_count > 0)
+    {
+        result._fallback_count  = remaining_count;
+        result._fallback_keys   = createDeviceArray<Key>(remaining_count);
+
+        thrust::gather(make_device(remaining), make_device(remaining) + remaining_count,
+                       make_device(keys),
+                       make_device(result._fallback_keys));
+    }
+
+
+    // Concatenate the levels and build the rank directory
+    index_t total_blocks = result._level_offsets[result._level_count] / bits_per_block;
+
+    result._bits    = createDeviceArray<block_type>(total_blocks, 0);
+    result._ranks   = createDeviceArray<index_t>(total_blocks, 0);
+
+    for (index_t level = 0; level < result._level_count; ++level)
+    {
+        copyDevice2DeviceArray<block_type>(level_blocks[level], result.level_bits(level) / bits_per_block,
+                                           result._bits + result._level_offsets[level] / bits_per_block,
+                                           MemoryCopy::NO_CHECK);
+
+        destroyDeviceArray<block_type>(level_blocks[level]);
+    }
+
+    thrust::transform(device_begin(result._bits), device_end(result._bits),
+                      device_begin(result._ranks),
+                      count_block_bits());
+
+    thrust::exclusive_scan(device_begin(result._ranks), device_end(result._ranks),
+                           device_begin(result._ranks));
+
+    result._size = n;
+
+    destroyDeviceArray<index_t>(remaining);
+    destroyDeviceArray<index_t>(next_remaining);
+
+    return result;
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+void
+minimal_perfect_hash<Key, Hash, KeyEqual>::destroyDeviceObject(minimal_perfect_hash<Key, Hash, KeyEqual>& device_object)
+{
+    if (device_object._bits != nullptr)
+    {
+        destroyDeviceArray<block_type>(device_object._bits);
+        destroyDeviceArray<index_t>(device_object._ranks);
+    }
+
+    if (device_object._fallback_keys != nullptr)
+    {
+        destroyDeviceArray<Key>(device_object._fallback_keys);
+    }
+
+    device_object._size             = 0;
+    device_object._level_count      = 0;
+    for (index_t level = 0; level <= max_levels; ++level)
+    {
+        device_object._level_offsets[level] = 0;
+    }
+    device_object._fallback_count   = 0;
+    device_object._hash             = hasher();
+    device_object._key_equal        = key_equal();
+}
+
+} // namespace detail
+
+} // namespace stdgpu
+
+
+
+#endif // STDGPU_MINIMAL_PERFECT_HASH_DETAIL_H
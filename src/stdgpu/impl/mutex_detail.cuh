@@ -16,6 +16,19 @@
 #ifndef STDGPU_MUTEX_DETAIL_H
 #define STDGPU_MUTEX_DETAIL_H
 
+#include <stdgpu/config.h>
+
+#if STDGPU_BACKEND == STDGPU_BACKEND_CUDA
+    #define STDGPU_BACKEND_MUTEX_HEADER <stdgpu/STDGPU_BACKEND_DIRECTORY/mutex.cuh>
+    #include STDGPU_BACKEND_MUTEX_HEADER
+    #undef STDGPU_BACKEND_MUTEX_HEADER
+#else
+    #define STDGPU_BACKEND_MUTEX_HEADER <stdgpu/STDGPU_BACKEND_DIRECTORY/mutex.h>
+    #include STDGPU_BACKEND_MUTEX_HEADER
+    #undef STDGPU_BACKEND_MUTEX_HEADER
+#endif
+
+#include <stdgpu/algorithm.h>
 #include <stdgpu/contract.h>
 
 
@@ -23,6 +36,36 @@
 namespace stdgpu
 {
 
+namespace detail
+{
+
+constexpr unsigned int backoff_min_nanoseconds = 8;
+constexpr unsigned int backoff_max_nanoseconds = 1024;
+
+constexpr unsigned int shared_mutex_writer = 1u << 31;
+
+template <typename Lockable>
+inline STDGPU_DEVICE_ONLY void
+lock_with_backoff(Lockable& lockable)
+{
+    unsigned int delay = backoff_min_nanoseconds;
+    while (true)
+    {
+        // Only try the expensive atomic operation if the mutex appears to be free (test-and-test-and-set)
+        if (!lockable.locked() && lockable.try_lock())
+        {
+            return;
+        }
+
+        stdgpu::STDGPU_BACKEND_NAMESPACE::backoff(delay);
+        delay = stdgpu::min<unsigned int>(2 * delay, backoff_max_nanoseconds);
+    }
+}
+
+} // namespace detail
+
+
+
 inline STDGPU_DEVICE_ONLY
 mutex_ref::operator mutex_array::reference()
 {
@@ -45,13 +88,31 @@ mutex_ref::try_lock()
 {
     // Change state to LOCKED
     // Test whether it was UNLOCKED previously --> TRUE : This call got the lock, FALSE : Other call got the lock
-    return !_lock_bits.set(_n);
+    bool acquired = !_lock_bits.set(_n);
+
+    // Acquire : Accesses of the critical section must not be moved before the lock
+    if (acquired)
+    {
+        atomic_thread_fence();
+    }
+
+    return acquired;
+}
+
+
+inline STDGPU_DEVICE_ONLY void
+mutex_ref::lock()
+{
+    detail::lock_with_backoff(*this);
 }
 
 
 inline STDGPU_DEVICE_ONLY void
 mutex_ref::unlock()
 {
+    // Release : Accesses of the critical section must be visible before the lock is released
+    atomic_thread_fence();
+
     // Change state back to UNLOCKED
     _lock_bits.reset(_n);
 }
@@ -78,13 +139,31 @@ mutex_array::reference::try_lock()
 {
     // Change state to LOCKED
     // Test whether it was UNLOCKED previously --> TRUE : This call got the lock, FALSE : Other call got the lock
-    return !(_bit_ref = true);
+    bool acquired = !(_bit_ref = true);
+
+    // Acquire : Accesses of the critical section must not be moved before the lock
+    if (acquired)
+    {
+        atomic_thread_fence();
+    }
+
+    return acquired;
+}
+
+
+inline STDGPU_DEVICE_ONLY void
+mutex_array::reference::lock()
+{
+    detail::lock_with_backoff(*this);
 }
 
 
 inline STDGPU_DEVICE_ONLY void
 mutex_array::reference::unlock()
 {
+    // Release : Accesses of the critical section must be visible before the lock is released
+    atomic_thread_fence();
+
     // Change state back to UNLOCKED
     _bit_ref = false;
 }
@@ -133,6 +212,186 @@ mutex_array::size() const
 
 
 
+inline STDGPU_HOST_DEVICE
+shared_mutex_array::reference::reference(unsigned int* state)
+    : _state(state)
+{
+
+}
+
+
+inline STDGPU_DEVICE_ONLY bool
+shared_mutex_array::reference::try_lock()
+{
+    // Change state from UNLOCKED to WRITER, fails if there is a writer or at least one reader
+    unsigned int expected = 0;
+    bool acquired = atomic_ref<unsigned int>(*_state).compare_exchange_strong(expected, detail::shared_mutex_writer);
+
+    if (acquired)
+    {
+        atomic_thread_fence();
+    }
+
+    return acquired;
+}
+
+
+inline STDGPU_DEVICE_ONLY void
+shared_mutex_array::reference::lock()
+{
+    unsigned int delay = detail::backoff_min_nanoseconds;
+    while (true)
+    {
+        if (atomic_ref<unsigned int>(*_state).load() == 0 && try_lock())
+        {
+            return;
+        }
+
+        stdgpu::STDGPU_BACKEND_NAMESPACE::backoff(delay);
+        delay = stdgpu::min<unsigned int>(2 * delay, detail::backoff_max_nanoseconds);
+    }
+}
+
+
+inline STDGPU_DEVICE_ONLY void
+shared_mutex_array::reference::unlock()
+{
+    atomic_thread_fence();
+
+    atomic_ref<unsigned int>(*_state).fetch_and(~detail::shared_mutex_writer);
+}
+
+
+inline STDGPU_DEVICE_ONLY bool
+shared_mutex_array::reference::try_lock_shared()
+{
+    // Increment the reader count as long as there is no writer
+    atomic_ref<unsigned int> state(*_state);
+    unsigned int expected = state.load();
+    while ((expected & detail::shared_mutex_writer) == 0)
+    {
+        if (state.compare_exchange_weak(expected, expected + 1))
+        {
+            atomic_thread_fence();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+inline STDGPU_DEVICE_ONLY void
+shared_mutex_array::reference::lock_shared()
+{
+    unsigned int delay = detail::backoff_min_nanoseconds;
+    while (true)
+    {
+        if (!locked() && try_lock_shared())
+        {
+            return;
+        }
+
+        stdgpu::STDGPU_BACKEND_NAMESPACE::backoff(delay);
+        delay = stdgpu::min<unsigned int>(2 * delay, detail::backoff_max_nanoseconds);
+    }
+}
+
+
+inline STDGPU_DEVICE_ONLY void
+shared_mutex_array::reference::unlock_shared()
+{
+    atomic_thread_fence();
+
+    atomic_ref<unsigned int>(*_state).fetch_sub(1);
+}
+
+
+inline STDGPU_DEVICE_ONLY bool
+shared_mutex_array::reference::locked() const
+{
+    return (atomic_ref<unsigned int>(*_state).load() & detail::shared_mutex_writer) != 0;
+}
+
+
+inline STDGPU_DEVICE_ONLY bool
+shared_mutex_array::reference::locked_shared() const
+{
+    return (atomic_ref<unsigned int>(*_state).load() & ~detail::shared_mutex_writer) != 0;
+}
+
+
+
+inline STDGPU_DEVICE_ONLY shared_mutex_array::reference
+shared_mutex_array::operator[](const index_t n)
+{
+    STDGPU_EXPECTS(0 <= n);
+    STDGPU_EXPECTS(n < size());
+
+    return reference(_states + n);
+}
+
+
+inline STDGPU_DEVICE_ONLY const shared_mutex_array::reference
+shared_mutex_array::operator[](const index_t n) const
+{
+    STDGPU_EXPECTS(0 <= n);
+    STDGPU_EXPECTS(n < size());
+
+    return reference(_states + n);
+}
+
+
+inline STDGPU_HOST_DEVICE bool
+shared_mutex_array::empty() const
+{
+    return (size() == 0);
+}
+
+
+inline STDGPU_HOST_DEVICE index_t
+shared_mutex_array::size() const
+{
+    return _size;
+}
+
+
+
+template <typename Lockable>
+inline STDGPU_DEVICE_ONLY
+lock_guard<Lockable>::lock_guard(Lockable lockable)
+    : _lockable(lockable)
+{
+    _lockable.lock();
+}
+
+
+template <typename Lockable>
+inline STDGPU_DEVICE_ONLY
+lock_guard<Lockable>::~lock_guard()
+{
+    _lockable.unlock();
+}
+
+
+template <typename SharedLockable>
+inline STDGPU_DEVICE_ONLY
+shared_lock_guard<SharedLockable>::shared_lock_guard(SharedLockable lockable)
+    : _lockable(lockable)
+{
+    _lockable.lock_shared();
+}
+
+
+template <typename SharedLockable>
+inline STDGPU_DEVICE_ONLY
+shared_lock_guard<SharedLockable>::~shared_lock_guard()
+{
+    _lockable.unlock_shared();
+}
+
+
+
 namespace detail
 {
 
@@ -0,0 +1,693 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_PRIORITY_QUEUE_DETAIL_H
+#define STDGPU_PRIORITY_QUEUE_DETAIL_H
+
+#include <thrust/copy.h>
+#include <thrust/fill.h>
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/logical.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/sort.h>
+
+#include <stdgpu/algorithm.h>
+#include <stdgpu/contract.h>
+#include <stdgpu/iterator.h>
+#include <stdgpu/memory.h>
+
+
+
+namespace stdgpu
+{
+
+namespace detail
+{
+
+template <typename T, typename Compare>
+struct priority_queue_push
+{
+    priority_queue<T, Compare> pool;
+
+    priority_queue_push(const priority_queue<T, Compare>& pool)
+        : pool(pool)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const T& value)
+    {
+        pool.push(value);
+    }
+};
+
+
+template <typename T>
+struct priority_queue_gather
+{
+    const T* data;
+    const int* heap_sizes;
+    const int* offsets;
+    T* values;
+    index_t heap_capacity;
+
+    priority_queue_gather(const T* data,
+                          const int* heap_sizes,
+                          const int* offsets,
+                          T* values,
+                          const index_t heap_capacity)
+        : data(data),
+          heap_sizes(heap_sizes),
+          offsets(offsets),
+          values(values),
+          heap_capacity(heap_capacity)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        index_t heap = i / heap_capacity;
+        index_t position = i % heap_capacity;
+
+        if (position < heap_sizes[heap])
+        {
+            values[offsets[heap] + position] = data[i];
+        }
+    }
+};
+
+
+template <typename T>
+struct priority_queue_scatter
+{
+    T* data;
+    const T* values;
+    index_t heap_count;
+    index_t heap_capacity;
+
+    priority_queue_scatter(T* data,
+                           const T* values,
+                           const index_t heap_count,
+                           const index_t heap_capacity)
+        : data(data),
+          values(values),
+          heap_count(heap_count),
+          heap_capacity(heap_capacity)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        // Every heap receives an ascending subsequence of the sorted values, which already satisfies the heap property
+        data[(i % heap_count) * heap_capacity + i / heap_count] = values[i];
+    }
+};
+
+
+struct priority_queue_scatter_size
+{
+    int* heap_sizes;
+    index_t heap_count;
+    index_t n;
+
+    priority_queue_scatter_size(int* heap_sizes,
+                                const index_t heap_count,
+                                const index_t n)
+        : heap_sizes(heap_sizes),
+          heap_count(heap_count),
+          n(n)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t heap)
+    {
+        heap_sizes[heap] = static_cast<int>((n - heap + heap_count - 1) / heap_count);
+    }
+};
+
+
+struct priority_queue_size_valid
+{
+    index_t heap_capacity;
+
+    priority_queue_size_valid(const index_t heap_capacity)
+        : heap_capacity(heap_capacity)
+    {
+
+    }
+
+    STDGPU_HOST_DEVICE bool
+    operator()(const int heap_size) const
+    {
+        return (0 <= heap_size && heap_size <= heap_capacity);
+    }
+};
+
+
+template <typename T, typename Compare>
+struct priority_queue_heap_property
+{
+    const T* data;
+    const int* heap_sizes;
+    index_t heap_capacity;
+    Compare compare;
+
+    priority_queue_heap_property(const T* data,
+                                 const int* heap_sizes,
+                                 const index_t heap_capacity,
+                                 Compare compare)
+        : data(data),
+          heap_sizes(heap_sizes),
+          heap_capacity(heap_capacity),
+          compare(compare)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY bool
+    operator()(const index_t i) const
+    {
+        index_t heap = i / heap_capacity;
+        index_t position = i % heap_capacity;
+
+        if (position == 0 || position >= heap_sizes[heap])
+        {
+            return true;
+        }
+
+        index_t parent = (position - 1) / 2;
+        return !compare(data[i], data[heap * heap_capacity + parent]);
+    }
+};
+
+} // namespace detail
+
+
+template <typename T, typename Compare>
+priority_queue<T, Compare>
+priority_queue<T, Compare>::createDeviceObject(const index_t& capacity,
+                                               const index_t& heap_count)
+{
+    STDGPU_EXPECTS(capacity > 0);
+    STDGPU_EXPECTS(heap_count > 0);
+
+    priority_queue<T, Compare> result;
+    result._heap_count      = heap_count;
+    result._heap_capacity   = (capacity + heap_count - 1) / heap_count;
+    result._capacity        = capacity;
+
+    allocator_type a;   // Will be replaced by member
+    result._data            = allocator_traits<allocator_type>::allocate(a, result._heap_count * result._heap_capacity);
+    result._heap_sizes      = createDeviceArray<int>(heap_count, 0);
+    result._locks           = mutex_array::createDeviceObject(heap_count);
+    result._size            = atomic<int>::createDeviceObject();
+    result._next            = atomic<unsigned int>::createDeviceObject();
+    result._compare         = value_compare();
+
+    return result;
+}
+
+template <typename T, typename Compare>
+void
+priority_queue<T, Compare>::destroyDeviceObject(priority_queue<T, Compare>& device_object)
+{
+    allocator_type a = device_object.get_allocator();   // Will be replaced by member
+    allocator_traits<allocator_type>::deallocate(a, device_object._data, device_object._heap_count * device_object._heap_capacity);
+    destroyDeviceArray<int>(device_object._heap_sizes);
+    mutex_array::destroyDeviceObject(device_object._locks);
+    atomic<int>::destroyDeviceObject(device_object._size);
+    atomic<unsigned int>::destroyDeviceObject(device_object._next);
+    device_object._heap_count = 0;
+    device_object._heap_capacity = 0;
+    device_object._capacity = 0;
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_HOST_DEVICE typename priority_queue<T, Compare>::allocator_type
+priority_queue<T, Compare>::get_allocator() const
+{
+    return allocator_type();
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_HOST_DEVICE typename priority_queue<T, Compare>::value_compare
+priority_queue<T, Compare>::value_comp() const
+{
+    return _compare;
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_DEVICE_ONLY bool
+priority_queue<T, Compare>::push(const T& element)
+{
+    if (!reserve_push(1))
+    {
+        printf("stdgpu::priority_queue::push : Object full\n");
+        return false;
+    }
+
+    // The reservation guarantees that some heap has space left
+    index_t heap = static_cast<index_t>(_next.fetch_inc_mod(static_cast<unsigned int>(_heap_count)));
+    while (true)
+    {
+        if (_heap_sizes[heap] < _heap_capacity && _locks[heap].try_lock())
+        {
+            // START --- critical section --- START
+
+            bool pushed = false;
+            if (_heap_sizes[heap] < _heap_capacity)
+            {
+                heap_push(heap, element);
+                pushed = true;
+            }
+
+            //  END  --- critical section ---  END
+            _locks[heap].unlock();
+
+            if (pushed)
+            {
+                return true;
+            }
+        }
+
+        heap = (heap + 1) % _heap_count;
+    }
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_DEVICE_ONLY bool
+priority_queue<T, Compare>::push_n(const T* elements,
+                                   const index_t n)
+{
+    STDGPU_EXPECTS(n >= 0);
+
+    if (!reserve_push(n))
+    {
+        printf("stdgpu::priority_queue::push_n : Not enough space left for %d elements\n", static_cast<int>(n));
+        return false;
+    }
+
+    // Fill the heaps one after another, such that most of the block is added while holding a single lock
+    index_t pushed_count = 0;
+    index_t heap = static_cast<index_t>(_next.fetch_inc_mod(static_cast<unsigned int>(_heap_count)));
+    while (pushed_count < n)
+    {
+        if (_heap_sizes[heap] < _heap_capacity && _locks[heap].try_lock())
+        {
+            // START --- critical section --- START
+
+            while (pushed_count < n && _heap_sizes[heap] < _heap_capacity)
+            {
+                heap_push(heap, elements[pushed_count]);
+                ++pushed_count;
+            }
+
+            //  END  --- critical section ---  END
+            _locks[heap].unlock();
+        }
+
+        heap = (heap + 1) % _heap_count;
+    }
+
+    return true;
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_DEVICE_ONLY thrust::pair<T, bool>
+priority_queue<T, Compare>::pop_min()
+{
+    if (reserve_pop(1) == 0)
+    {
+        return thrust::make_pair(T(), false);
+    }
+
+    // The reservation guarantees that some heap holds or will hold an element for this call
+    while (true)
+    {
+        index_t heap = choose_heap();
+
+        if (_heap_sizes[heap] > 0 && _locks[heap].try_lock())
+        {
+            // START --- critical section --- START
+
+            bool popped = false;
+            T element = T();
+            if (_heap_sizes[heap] > 0)
+            {
+                element = heap_pop(heap);
+                popped = true;
+            }
+
+            //  END  --- critical section ---  END
+            _locks[heap].unlock();
+
+            if (popped)
+            {
+                return thrust::make_pair(element, true);
+            }
+        }
+    }
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_DEVICE_ONLY index_t
+priority_queue<T, Compare>::pop_k(T* elements,
+                                  const index_t k)
+{
+    STDGPU_EXPECTS(k >= 0);
+
+    const index_t popped_count = reserve_pop(k);
+
+    // Choose the heap again for every element, such that each one is taken from the better of two heaps as in pop_min()
+    index_t taken_count = 0;
+    while (taken_count < popped_count)
+    {
+        index_t heap = choose_heap();
+
+        if (_heap_sizes[heap] > 0 && _locks[heap].try_lock())
+        {
+            // START --- critical section --- START
+
+            if (_heap_sizes[heap] > 0)
+            {
+                elements[taken_count] = heap_pop(heap);
+                ++taken_count;
+            }
+
+            //  END  --- critical section ---  END
+            _locks[heap].unlock();
+        }
+    }
+
+    return popped_count;
+}
+
+
+template <typename T, typename Compare>
+inline bool
+priority_queue<T, Compare>::push(device_ptr<const T> begin,
+                                 device_ptr<const T> end)
+{
+    const index_t n = static_cast<index_t>(end - begin);
+
+    STDGPU_EXPECTS(n >= 0);
+
+    if (size() + n > capacity())
+    {
+        printf("stdgpu::priority_queue::push : Not enough space left for %d elements\n", static_cast<int>(n));
+        return false;
+    }
+
+    thrust::for_each(begin, end,
+                     detail::priority_queue_push<T, Compare>(*this));
+
+    return true;
+}
+
+
+template <typename T, typename Compare>
+inline index_t
+priority_queue<T, Compare>::pop(device_ptr<T> begin,
+                                device_ptr<T> end)
+{
+    STDGPU_EXPECTS(end - begin >= 0);
+
+    const index_t current_size = size();
+    const index_t n = stdgpu::min<index_t>(static_cast<index_t>(end - begin), current_size);
+
+    if (n == 0) return 0;
+
+    // Gather all elements into one contiguous array and sort it
+    int* offsets = createDeviceArray<int>(_heap_count);
+    thrust::exclusive_scan(stdgpu::device_cbegin(_heap_sizes), stdgpu::device_cend(_heap_sizes),
+                           stdgpu::device_begin(offsets));
+
+    T* values = createDeviceArray<T>(current_size);
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(_heap_count * _heap_capacity),
+                     detail::priority_queue_gather<T>(_data, _heap_sizes, offsets, values, _heap_capacity));
+
+    thrust::sort(stdgpu::device_begin(values), stdgpu::device_end(values), _compare);
+
+    thrust::copy(stdgpu::device_cbegin(values), stdgpu::device_cbegin(values) + n,
+                 begin);
+
+    // Distribute the remaining sorted elements round-robin, which keeps the heaps balanced
+    const index_t remaining_count = current_size - n;
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(remaining_count),
+                     detail::priority_queue_scatter<T>(_data, values + n, _heap_count, _heap_capacity));
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(_heap_count),
+                     detail::priority_queue_scatter_size(_heap_sizes, _heap_count, remaining_count));
+
+    _size.store(static_cast<int>(remaining_count));
+
+    destroyDeviceArray<int>(offsets);
+    destroyDeviceArray<T>(values);
+
+    return n;
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_HOST_DEVICE bool
+priority_queue<T, Compare>::empty() const
+{
+    return (size() == 0);
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_HOST_DEVICE bool
+priority_queue<T, Compare>::full() const
+{
+    return (size() == max_size());
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_HOST_DEVICE index_t
+priority_queue<T, Compare>::size() const
+{
+    return static_cast<index_t>(_size.load());
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_HOST_DEVICE index_t
+priority_queue<T, Compare>::max_size() const
+{
+    return capacity();
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_HOST_DEVICE index_t
+priority_queue<T, Compare>::capacity() const
+{
+    return _capacity;
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_HOST_DEVICE index_t
+priority_queue<T, Compare>::heap_count() const
+{
+    return _heap_count;
+}
+
+
+template <typename T, typename Compare>
+inline void
+priority_queue<T, Compare>::clear()
+{
+    // Trivially copyable elements need not be destroyed
+    thrust::fill(stdgpu::device_begin(_heap_sizes), stdgpu::device_end(_heap_sizes),
+                 0);
+
+    _size.store(0);
+
+    STDGPU_ENSURES(empty());
+    STDGPU_ENSURES(valid());
+}
+
+
+template <typename T, typename Compare>
+inline bool
+priority_queue<T, Compare>::valid() const
+{
+    // Special case : Zero capacity is valid
+    if (capacity() == 0) return true;
+
+    if (!thrust::all_of(stdgpu::device_cbegin(_heap_sizes), stdgpu::device_cend(_heap_sizes),
+                        detail::priority_queue_size_valid(_heap_capacity)))
+    {
+        return false;
+    }
+
+    int stored_count = thrust::reduce(stdgpu::device_cbegin(_heap_sizes), stdgpu::device_cend(_heap_sizes),
+                                      0,
+                                      thrust::plus<int>());
+
+    return (stored_count == _size.load()
+         && _locks.valid()
+         && thrust::all_of(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(_heap_count * _heap_capacity),
+                           detail::priority_queue_heap_property<T, Compare>(_data, _heap_sizes, _heap_capacity, _compare)));
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_DEVICE_ONLY bool
+priority_queue<T, Compare>::reserve_push(const index_t n)
+{
+    int current_size = _size.load();
+    do
+    {
+        if (current_size + n > _capacity)
+        {
+            return false;
+        }
+    }
+    while (!_size.compare_exchange_weak(current_size, current_size + static_cast<int>(n)));
+
+    return true;
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_DEVICE_ONLY index_t
+priority_queue<T, Compare>::reserve_pop(const index_t n)
+{
+    int current_size = _size.load();
+    int count = 0;
+    do
+    {
+        count = static_cast<int>(stdgpu::min<index_t>(current_size, n));
+        if (count <= 0)
+        {
+            return 0;
+        }
+    }
+    while (!_size.compare_exchange_weak(current_size, current_size - count));
+
+    return static_cast<index_t>(count);
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_DEVICE_ONLY index_t
+priority_queue<T, Compare>::choose_heap()
+{
+    // The two random choices of the MultiQueue are replaced by the next round-robin position and the heap opposite to it
+    index_t first  = static_cast<index_t>(_next.fetch_inc_mod(static_cast<unsigned int>(_heap_count)));
+    index_t second = (first + _heap_count / 2) % _heap_count;
+
+    int first_size  = _heap_sizes[first];
+    int second_size = _heap_sizes[second];
+
+    if (first_size == 0) return second;
+    if (second_size == 0) return first;
+
+    // The smallest elements are read without holding the locks, so the choice is only a heuristic
+    return _compare(_data[second * _heap_capacity], _data[first * _heap_capacity]) ? second : first;
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_DEVICE_ONLY void
+priority_queue<T, Compare>::heap_push(const index_t heap,
+                                      const T& element)
+{
+    T* heap_data = _data + heap * _heap_capacity;
+
+    index_t position = static_cast<index_t>(_heap_sizes[heap]);
+    ++_heap_sizes[heap];
+
+    // Sift up
+    while (position > 0)
+    {
+        index_t parent = (position - 1) / 2;
+        if (!_compare(element, heap_data[parent]))
+        {
+            break;
+        }
+
+        heap_data[position] = heap_data[parent];
+        position = parent;
+    }
+
+    heap_data[position] = element;
+}
+
+
+template <typename T, typename Compare>
+inline STDGPU_DEVICE_ONLY T
+priority_queue<T, Compare>::heap_pop(const index_t heap)
+{
+    T* heap_data = _data + heap * _heap_capacity;
+
+    T top = heap_data[0];
+
+    --_heap_sizes[heap];
+    const index_t n = static_cast<index_t>(_heap_sizes[heap]);
+
+    if (n == 0)
+    {
+        return top;
+    }
+
+    // Sift down
+    T last = heap_data[n];
+    index_t position = 0;
+    while (2 * position + 1 < n)
+    {
+        index_t child = 2 * position + 1;
+        if (child + 1 < n && _compare(heap_data[child + 1], heap_data[child]))
+        {
+            ++child;
+        }
+
+        if (!_compare(heap_data[child], last))
+        {
+            break;
+        }
+
+        heap_data[position] = heap_data[child];
+        position = child;
+    }
+
+    heap_data[position] = last;
+
+    return top;
+}
+
+} // namespace stdgpu
+
+
+
+#endif // STDGPU_PRIORITY_QUEUE_DETAIL_H
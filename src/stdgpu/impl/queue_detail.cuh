@@ -61,6 +61,64 @@ queue<T, ContainerT>::pop()
 }
 
 
+template <typename T,
+          typename ContainerT>
+inline STDGPU_DEVICE_ONLY bool
+queue<T, ContainerT>::try_push(const T& element)
+{
+    return _c.try_push_back(element);
+}
+
+
+template <typename T,
+          typename ContainerT>
+inline STDGPU_DEVICE_ONLY thrust::pair<T, bool>
+queue<T, ContainerT>::try_pop()
+{
+    return _c.try_pop_front();
+}
+
+
+template <typename T,
+          typename ContainerT>
+inline STDGPU_DEVICE_ONLY bool
+queue<T, ContainerT>::push_n(const T* elements,
+                             const index_t n)
+{
+    return _c.push_back_n(elements, n);
+}
+
+
+template <typename T,
+          typename ContainerT>
+inline STDGPU_DEVICE_ONLY index_t
+queue<T, ContainerT>::pop_n(T* elements,
+                            const index_t n)
+{
+    return _c.pop_front_n(elements, n);
+}
+
+
+template <typename T,
+          typename ContainerT>
+inline bool
+queue<T, ContainerT>::push(device_ptr<const T> begin,
+                           device_ptr<const T> end)
+{
+    return _c.push_back(begin, end);
+}
+
+
+template <typename T,
+          typename ContainerT>
+inline index_t
+queue<T, ContainerT>::pop(device_ptr<T> begin,
+                          device_ptr<T> end)
+{
+    return _c.pop_front(begin, end);
+}
+
+
 template <typename T,
           typename ContainerT>
 inline STDGPU_HOST_DEVICE bool
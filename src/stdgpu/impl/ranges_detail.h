@@ -140,8 +140,90 @@ struct select
     T* _values;
 };
 
+
+struct ring_position
+{
+    STDGPU_HOST_DEVICE
+    ring_position(const index_t begin,
+                  const index_t capacity)
+        : _begin(begin),
+          _capacity(capacity)
+    {
+
+    }
+
+    STDGPU_HOST_DEVICE index_t
+    operator()(const index_t i) const
+    {
+        // Both begin and i are smaller than the capacity, so a single subtraction replaces the modulo
+        index_t position = _begin + i;
+        return (position < _capacity) ? position : position - _capacity;
+    }
+
+    index_t _begin;
+    index_t _capacity;
+};
+
 } // namespace detail
 
+
+template <typename T>
+STDGPU_HOST_DEVICE
+device_ring_range<T>::device_ring_range(T* p,
+                                        index_t capacity,
+                                        index_t begin,
+                                        index_t n)
+    : _data(p),
+      _capacity(capacity),
+      _begin(begin),
+      _size(n)
+{
+
+}
+
+
+template <typename T>
+STDGPU_HOST_DEVICE typename device_ring_range<T>::iterator
+device_ring_range<T>::begin()
+{
+    return iterator(stdgpu::make_device(_data),
+                    thrust::make_transform_iterator(thrust::counting_iterator<index_t>(0), detail::ring_position(_begin, _capacity)));
+}
+
+
+template <typename T>
+STDGPU_HOST_DEVICE typename device_ring_range<T>::iterator
+device_ring_range<T>::end()
+{
+    return begin() + _size;
+}
+
+
+template <typename T>
+STDGPU_HOST_DEVICE index_t
+device_ring_range<T>::size() const
+{
+    return _size;
+}
+
+
+template <typename T>
+STDGPU_HOST_DEVICE device_range<T>
+device_ring_range<T>::first_segment() const
+{
+    index_t n = (_begin + _size < _capacity) ? _size : _capacity - _begin;
+    return device_range<T>(_data + _begin, n);
+}
+
+
+template <typename T>
+STDGPU_HOST_DEVICE device_range<T>
+device_ring_range<T>::second_segment() const
+{
+    index_t n = (_begin + _size < _capacity) ? 0 : _begin + _size - _capacity;
+    return device_range<T>(_data, n);
+}
+
 } // namespace stdgpu
 
 
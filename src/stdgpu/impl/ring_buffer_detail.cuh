@@ -0,0 +1,635 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_RING_BUFFER_DETAIL_H
+#define STDGPU_RING_BUFFER_DETAIL_H
+
+#include <new>
+
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/logical.h>
+#include <thrust/sequence.h>
+
+#include <stdgpu/algorithm.h>
+#include <stdgpu/contract.h>
+#include <stdgpu/iterator.h>
+#include <stdgpu/memory.h>
+#include <stdgpu/utility.h>
+
+
+
+namespace stdgpu
+{
+
+namespace detail
+{
+
+template <typename T, typename SequenceType>
+struct ring_buffer_destroy_value
+{
+    T* data;
+    SequenceType begin;
+    index_t capacity;
+
+    ring_buffer_destroy_value(T* data,
+                              const SequenceType begin,
+                              const index_t capacity)
+        : data(data),
+          begin(begin),
+          capacity(capacity)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        destroy_at(&(data[(begin + static_cast<SequenceType>(i)) % static_cast<SequenceType>(capacity)]));
+    }
+};
+
+
+template <typename T, typename SequenceType>
+struct ring_buffer_push_value
+{
+    T* data;
+    SequenceType* sequences;
+    const T* values;
+    SequenceType end;
+    index_t capacity;
+
+    ring_buffer_push_value(T* data,
+                           SequenceType* sequences,
+                           const T* values,
+                           const SequenceType end,
+                           const index_t capacity)
+        : data(data),
+          sequences(sequences),
+          values(values),
+          end(end),
+          capacity(capacity)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        const SequenceType position = end + static_cast<SequenceType>(i);
+        const SequenceType cell = position % static_cast<SequenceType>(capacity);
+
+        ::new (static_cast<void*>(&(data[cell]))) T(values[i]);
+        sequences[cell] = position + 1;
+    }
+};
+
+
+template <typename T, typename SequenceType>
+struct ring_buffer_pop_value
+{
+    T* data;
+    SequenceType* sequences;
+    T* values;
+    SequenceType begin;
+    index_t capacity;
+
+    ring_buffer_pop_value(T* data,
+                          SequenceType* sequences,
+                          T* values,
+                          const SequenceType begin,
+                          const index_t capacity)
+        : data(data),
+          sequences(sequences),
+          values(values),
+          begin(begin),
+          capacity(capacity)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        const SequenceType position = begin + static_cast<SequenceType>(i);
+        const SequenceType cell = position % static_cast<SequenceType>(capacity);
+
+        values[i] = stdgpu::move(data[cell]);
+        destroy_at(&(data[cell]));
+        sequences[cell] = position + static_cast<SequenceType>(capacity);
+    }
+};
+
+
+template <typename SequenceType>
+struct ring_buffer_sequence_valid
+{
+    const SequenceType* sequences;
+    SequenceType begin;
+    SequenceType end;
+    index_t capacity;
+
+    ring_buffer_sequence_valid(const SequenceType* sequences,
+                               const SequenceType begin,
+                               const SequenceType end,
+                               const index_t capacity)
+        : sequences(sequences),
+          begin(begin),
+          end(end),
+          capacity(capacity)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY bool
+    operator()(const index_t i) const
+    {
+        const SequenceType n = static_cast<SequenceType>(capacity);
+        const SequenceType cell = static_cast<SequenceType>(i);
+
+        // The position which currently owns the cell, either the stored element or the next element to be pushed
+        const SequenceType position = begin + (cell + n - begin % n) % n;
+
+        return sequences[i] == ((position < end) ? position + 1 : position);
+    }
+};
+
+} // namespace detail
+
+
+template <typename T>
+ring_buffer<T>
+ring_buffer<T>::createDeviceObject(const index_t& capacity)
+{
+    STDGPU_EXPECTS(capacity > 0);
+
+    ring_buffer<T> result;
+    allocator_type a;   // Will be replaced by member
+    result._data        = allocator_traits<allocator_type>::allocate(a, capacity);
+    result._sequences   = createDeviceArray<sequence_type>(capacity);
+    result._begin       = atomic<sequence_type>::createDeviceObject();
+    result._end         = atomic<sequence_type>::createDeviceObject();
+    result._capacity    = capacity;
+
+    // Cell i is ready for the push of position i
+    thrust::sequence(stdgpu::device_begin(result._sequences), stdgpu::device_end(result._sequences));
+
+    return result;
+}
+
+template <typename T>
+void
+ring_buffer<T>::destroyDeviceObject(ring_buffer<T>& device_object)
+{
+    device_object.clear();
+
+    allocator_type a = device_object.get_allocator();   // Will be replaced by member
+    allocator_traits<allocator_type>::deallocate(a, device_object._data, device_object._capacity);
+    destroyDeviceArray<sequence_type>(device_object._sequences);
+    atomic<sequence_type>::destroyDeviceObject(device_object._begin);
+    atomic<sequence_type>::destroyDeviceObject(device_object._end);
+    device_object._capacity = 0;
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE typename ring_buffer<T>::allocator_type
+ring_buffer<T>::get_allocator() const
+{
+    return allocator_type();
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY bool
+ring_buffer<T>::try_push_back(const T& element)
+{
+    const sequence_type n = static_cast<sequence_type>(_capacity);
+
+    sequence_type position = _end.load();
+    while (true)
+    {
+        sequence_type sequence = atomic_ref<sequence_type>(_sequences[position % n]).load();
+
+        // Unsigned wrap-around yields the signed distance between the sequence number and the position
+        long long int difference = static_cast<long long int>(sequence - position);
+
+        if (difference == 0)
+        {
+            // On failure, position is updated to the current value
+            if (_end.compare_exchange_weak(position, position + 1))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The cell still holds the element pushed one round earlier
+            return false;
+        }
+        else
+        {
+            position = _end.load();
+        }
+    }
+
+    // Acquire : The previous consumer of the cell must have finished before it is overwritten
+    atomic_thread_fence();
+
+    allocator_type a = get_allocator();     // Will be replaced by member
+    allocator_traits<allocator_type>::construct(a, &(_data[position % n]), element);
+
+    // Hand the cell over to the consumer of this position, which must not observe the sequence number before the element
+    atomic_thread_fence();
+    atomic_ref<sequence_type>(_sequences[position % n]).store(position + 1);
+
+    return true;
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY thrust::pair<T, bool>
+ring_buffer<T>::try_pop_front()
+{
+    const sequence_type n = static_cast<sequence_type>(_capacity);
+
+    sequence_type position = _begin.load();
+    while (true)
+    {
+        sequence_type sequence = atomic_ref<sequence_type>(_sequences[position % n]).load();
+
+        // Unsigned wrap-around yields the signed distance between the sequence number and the position
+        long long int difference = static_cast<long long int>(sequence - (position + 1));
+
+        if (difference == 0)
+        {
+            // On failure, position is updated to the current value
+            if (_begin.compare_exchange_weak(position, position + 1))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The element of this position has not been pushed yet
+            return thrust::make_pair(T(), false);
+        }
+        else
+        {
+            position = _begin.load();
+        }
+    }
+
+    // Acquire : The element must not be read before the sequence number which announced it
+    atomic_thread_fence();
+
+    thrust::pair<T, bool> popped = thrust::make_pair(stdgpu::move(_data[position % n]), true);
+
+    allocator_type a = get_allocator();     // Will be replaced by member
+    allocator_traits<allocator_type>::destroy(a, &(_data[position % n]));
+
+    // Hand the cell over to the producer of the position one round later
+    atomic_thread_fence();
+    atomic_ref<sequence_type>(_sequences[position % n]).store(position + n);
+
+    return popped;
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY bool
+ring_buffer<T>::push_back(const T& element)
+{
+    bool pushed = try_push_back(element);
+
+    if (!pushed)
+    {
+        printf("stdgpu::ring_buffer::push_back : Object full\n");
+    }
+
+    return pushed;
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY thrust::pair<T, bool>
+ring_buffer<T>::pop_front()
+{
+    thrust::pair<T, bool> popped = try_pop_front();
+
+    if (!popped.second)
+    {
+        printf("stdgpu::ring_buffer::pop_front : Object empty\n");
+    }
+
+    return popped;
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY bool
+ring_buffer<T>::push_back_n(const T* elements,
+                            const index_t n)
+{
+    STDGPU_EXPECTS(0 <= n);
+    STDGPU_EXPECTS(n <= capacity());
+
+    if (n == 0) return true;
+
+    const sequence_type cells = static_cast<sequence_type>(_capacity);
+
+    sequence_type position = _end.load();
+    while (true)
+    {
+        // The cells of a block are only modified by the owners of its positions, so checking them before the reservation is sufficient
+        bool no_space_left = false;
+        bool outdated = false;
+        for (index_t i = 0; i < n; ++i)
+        {
+            sequence_type cell_position = position + static_cast<sequence_type>(i);
+            sequence_type sequence = atomic_ref<sequence_type>(_sequences[cell_position % cells]).load();
+
+            long long int difference = static_cast<long long int>(sequence - cell_position);
+            if (difference < 0)
+            {
+                no_space_left = true;
+                break;
+            }
+            if (difference > 0)
+            {
+                outdated = true;
+                break;
+            }
+        }
+
+        if (no_space_left)
+        {
+            printf("stdgpu::ring_buffer::push_back_n : Not enough space left for %d elements\n", static_cast<int>(n));
+            return false;
+        }
+
+        if (outdated)
+        {
+            position = _end.load();
+        }
+        else if (_end.compare_exchange_weak(position, position + static_cast<sequence_type>(n)))
+        {
+            break;
+        }
+    }
+
+    atomic_thread_fence();
+
+    allocator_type a = get_allocator();     // Will be replaced by member
+    for (index_t i = 0; i < n; ++i)
+    {
+        sequence_type cell_position = position + static_cast<sequence_type>(i);
+
+        allocator_traits<allocator_type>::construct(a, &(_data[cell_position % cells]), elements[i]);
+    }
+
+    // A single fence publishes the whole block before any of its sequence numbers
+    atomic_thread_fence();
+    for (index_t i = 0; i < n; ++i)
+    {
+        sequence_type cell_position = position + static_cast<sequence_type>(i);
+
+        atomic_ref<sequence_type>(_sequences[cell_position % cells]).store(cell_position + 1);
+    }
+
+    return true;
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY index_t
+ring_buffer<T>::pop_front_n(T* elements,
+                            const index_t n)
+{
+    STDGPU_EXPECTS(n >= 0);
+
+    const sequence_type cells = static_cast<sequence_type>(_capacity);
+    const index_t max_count = stdgpu::min<index_t>(n, _capacity);
+
+    sequence_type position = _begin.load();
+    index_t popped_count = 0;
+    while (true)
+    {
+        // Count the leading elements whose push has finished
+        bool outdated = false;
+        popped_count = 0;
+        for (index_t i = 0; i < max_count; ++i)
+        {
+            sequence_type cell_position = position + static_cast<sequence_type>(i);
+            sequence_type sequence = atomic_ref<sequence_type>(_sequences[cell_position % cells]).load();
+
+            long long int difference = static_cast<long long int>(sequence - (cell_position + 1));
+            if (difference < 0)
+            {
+                break;
+            }
+            if (difference > 0)
+            {
+                outdated = true;
+                break;
+            }
+
+            ++popped_count;
+        }
+
+        if (outdated)
+        {
+            position = _begin.load();
+        }
+        else if (popped_count == 0)
+        {
+            return 0;
+        }
+        else if (_begin.compare_exchange_weak(position, position + static_cast<sequence_type>(popped_count)))
+        {
+            break;
+        }
+    }
+
+    atomic_thread_fence();
+
+    allocator_type a = get_allocator();     // Will be replaced by member
+    for (index_t i = 0; i < popped_count; ++i)
+    {
+        sequence_type cell_position = position + static_cast<sequence_type>(i);
+
+        elements[i] = stdgpu::move(_data[cell_position % cells]);
+        allocator_traits<allocator_type>::destroy(a, &(_data[cell_position % cells]));
+    }
+
+    // A single fence releases the whole block before any of its cells is handed over
+    atomic_thread_fence();
+    for (index_t i = 0; i < popped_count; ++i)
+    {
+        sequence_type cell_position = position + static_cast<sequence_type>(i);
+
+        atomic_ref<sequence_type>(_sequences[cell_position % cells]).store(cell_position + cells);
+    }
+
+    return popped_count;
+}
+
+
+template <typename T>
+inline bool
+ring_buffer<T>::push_back(device_ptr<const T> begin,
+                          device_ptr<const T> end)
+{
+    const index_t n = static_cast<index_t>(end - begin);
+
+    STDGPU_EXPECTS(n >= 0);
+
+    if (size() + n > capacity())
+    {
+        printf("stdgpu::ring_buffer::push_back : Not enough space left for %d elements\n", static_cast<int>(n));
+        return false;
+    }
+
+    const sequence_type current_end = _end.load();
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(n),
+                     detail::ring_buffer_push_value<T, sequence_type>(_data, _sequences, begin.get(), current_end, _capacity));
+
+    _end.store(current_end + static_cast<sequence_type>(n));
+
+    return true;
+}
+
+
+template <typename T>
+inline index_t
+ring_buffer<T>::pop_front(device_ptr<T> begin,
+                          device_ptr<T> end)
+{
+    STDGPU_EXPECTS(end - begin >= 0);
+
+    const index_t n = stdgpu::min<index_t>(static_cast<index_t>(end - begin), size());
+
+    const sequence_type current_begin = _begin.load();
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(n),
+                     detail::ring_buffer_pop_value<T, sequence_type>(_data, _sequences, begin.get(), current_begin, _capacity));
+
+    _begin.store(current_begin + static_cast<sequence_type>(n));
+
+    return n;
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE bool
+ring_buffer<T>::empty() const
+{
+    return (size() == 0);
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE bool
+ring_buffer<T>::full() const
+{
+    return (size() == max_size());
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE index_t
+ring_buffer<T>::size() const
+{
+    // Read the begin first such that concurrent pops can only decrease the difference
+    sequence_type current_begin = _begin.load();
+    sequence_type current_end   = _end.load();
+
+    long long int current_size = static_cast<long long int>(current_end - current_begin);
+
+    // Concurrent operations may shift both positions in between the two reads
+    if (current_size < 0)
+    {
+        return 0;
+    }
+    else if (current_size > static_cast<long long int>(_capacity))
+    {
+        return _capacity;
+    }
+
+    return static_cast<index_t>(current_size);
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE index_t
+ring_buffer<T>::max_size() const
+{
+    return capacity();
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE index_t
+ring_buffer<T>::capacity() const
+{
+    return _capacity;
+}
+
+
+template <typename T>
+inline void
+ring_buffer<T>::clear()
+{
+    if (!empty())
+    {
+        thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(size()),
+                         detail::ring_buffer_destroy_value<T, sequence_type>(_data, _begin.load(), _capacity));
+    }
+
+    thrust::sequence(stdgpu::device_begin(_sequences), stdgpu::device_end(_sequences));
+
+    _begin.store(0);
+    _end.store(0);
+
+    STDGPU_ENSURES(empty());
+    STDGPU_ENSURES(valid());
+}
+
+
+template <typename T>
+inline bool
+ring_buffer<T>::valid() const
+{
+    // Special case : Zero capacity is valid
+    if (capacity() == 0) return true;
+
+    sequence_type current_begin = _begin.load();
+    sequence_type current_end   = _end.load();
+
+    if (current_end < current_begin || current_end - current_begin > static_cast<sequence_type>(_capacity))
+    {
+        return false;
+    }
+
+    return thrust::all_of(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(_capacity),
+                          detail::ring_buffer_sequence_valid<sequence_type>(_sequences, current_begin, current_end, _capacity));
+}
+
+} // namespace stdgpu
+
+
+
+#endif // STDGPU_RING_BUFFER_DETAIL_H
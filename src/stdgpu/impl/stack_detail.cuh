@@ -61,6 +61,26 @@ stack<T, ContainerT>::pop()
 }
 
 
+template <typename T,
+          typename ContainerT>
+inline STDGPU_DEVICE_ONLY bool
+stack<T, ContainerT>::push_n(const T* elements,
+                             const index_t n)
+{
+    return _c.push_back_n(elements, n);
+}
+
+
+template <typename T,
+          typename ContainerT>
+inline STDGPU_DEVICE_ONLY index_t
+stack<T, ContainerT>::pop_n(T* elements,
+                            const index_t n)
+{
+    return _c.pop_back_n(elements, n);
+}
+
+
 template <typename T,
           typename ContainerT>
 inline STDGPU_HOST_DEVICE bool
@@ -0,0 +1,386 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_STATIC_MAP_DETAIL_H
+#define STDGPU_STATIC_MAP_DETAIL_H
+
+#include <thrust/distance.h>
+#include <thrust/for_each.h>
+#include <thrust/gather.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/logical.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/unique.h>
+
+#include <stdgpu/contract.h>
+#include <stdgpu/iterator.h>
+#include <stdgpu/memory.h>
+#include <stdgpu/impl/unordered_base.cuh>
+
+
+
+namespace stdgpu
+{
+
+namespace detail
+{
+
+template <typename Pair>
+struct static_map_select_key
+{
+    STDGPU_HOST_DEVICE typename Pair::first_type
+    operator()(const Pair& pair) const
+    {
+        return pair.first;
+    }
+};
+
+
+struct static_map_less_group_index
+{
+    const index_t* groups;
+
+    static_map_less_group_index(const index_t* groups)
+        : groups(groups)
+    {
+
+    }
+
+    STDGPU_HOST_DEVICE bool
+    operator()(const index_t a,
+               const index_t b) const
+    {
+        // Break ties by the input position such that the first occurrence of each key comes first
+        return (groups[a] < groups[b])
+            || (groups[a] == groups[b] && a < b);
+    }
+};
+
+
+struct static_map_equal_group
+{
+    const index_t* groups;
+
+    static_map_equal_group(const index_t* groups)
+        : groups(groups)
+    {
+
+    }
+
+    STDGPU_HOST_DEVICE bool
+    operator()(const index_t a,
+               const index_t b) const
+    {
+        return groups[a] == groups[b];
+    }
+};
+
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+struct static_map_place_value
+{
+    minimal_perfect_hash<Key, Hash, KeyEqual> index;
+    const Key* keys;
+    const index_t* input_indices;
+    const Value* input;
+    Value* values;
+
+    static_map_place_value(const minimal_perfect_hash<Key, Hash, KeyEqual>& index,
+                           const Key* keys,
+                           const index_t* input_indices,
+                           const Value* input,
+                           Value* values)
+        : index(index),
+          keys(keys),
+          input_indices(input_indices),
+          input(input),
+          values(values)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        index_t position = index(keys[i]);
+
+        safe_device_allocator<Value> a;
+        allocator_traits<safe_device_allocator<Value>>::construct(a, &(values[position]), input[input_indices[i]]);
+    }
+};
+
+
+template <typename Value>
+struct static_map_destroy_value
+{
+    Value* values;
+
+    static_map_destroy_value(Value* values)
+        : values(values)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        safe_device_allocator<Value> a;
+        allocator_traits<safe_device_allocator<Value>>::destroy(a, &(values[i]));
+    }
+};
+
+
+template <typename Map>
+struct static_map_value_reachable
+{
+    Map map;
+
+    static_map_value_reachable(const Map& map)
+        : map(map)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY bool
+    operator()(const typename Map::value_type& value) const
+    {
+        auto it = map.find(value.first);
+
+        if (it == map.end() || &(*it) != &value)
+        {
+            printf("stdgpu::static_map : Unreachable entry\n");
+            return false;
+        }
+
+        return true;
+    }
+};
+
+} // namespace detail
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename static_map<Key, T, Hash, KeyEqual>::allocator_type
+static_map<Key, T, Hash, KeyEqual>::get_allocator() const
+{
+    return allocator_type();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename static_map<Key, T, Hash, KeyEqual>::const_iterator
+static_map<Key, T, Hash, KeyEqual>::begin() const
+{
+    return _values;
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename static_map<Key, T, Hash, KeyEqual>::const_iterator
+static_map<Key, T, Hash, KeyEqual>::cbegin() const
+{
+    return begin();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename static_map<Key, T, Hash, KeyEqual>::const_iterator
+static_map<Key, T, Hash, KeyEqual>::end() const
+{
+    return _values + size();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename static_map<Key, T, Hash, KeyEqual>::const_iterator
+static_map<Key, T, Hash, KeyEqual>::cend() const
+{
+    return end();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+stdgpu::device_range<const typename static_map<Key, T, Hash, KeyEqual>::value_type>
+static_map<Key, T, Hash, KeyEqual>::device_range() const
+{
+    return stdgpu::device_range<const value_type>(_values, size());
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY index_t
+static_map<Key, T, Hash, KeyEqual>::count(const key_type& key) const
+{
+    return contains(key) ? index_t(1) : index_t(0);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename static_map<Key, T, Hash, KeyEqual>::const_iterator
+static_map<Key, T, Hash, KeyEqual>::find(const key_type& key) const
+{
+    index_t position = _index(key);
+
+    if (position < size()
+     && _key_equal(_values[position].first, key))
+    {
+        return _values + position;
+    }
+
+    return end();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY bool
+static_map<Key, T, Hash, KeyEqual>::contains(const key_type& key) const
+{
+    return find(key) != end();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE bool
+static_map<Key, T, Hash, KeyEqual>::empty() const
+{
+    return (size() == 0);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+static_map<Key, T, Hash, KeyEqual>::size() const
+{
+    return _index.size();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename static_map<Key, T, Hash, KeyEqual>::hasher
+static_map<Key, T, Hash, KeyEqual>::hash_function() const
+{
+    return _index._hash;
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename static_map<Key, T, Hash, KeyEqual>::key_equal
+static_map<Key, T, Hash, KeyEqual>::key_eq() const
+{
+    return _key_equal;
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+bool
+static_map<Key, T, Hash, KeyEqual>::valid() const
+{
+    // Special case : Zero size is valid
+    if (size() == 0) return true;
+
+    auto range = device_range();
+    return thrust::all_of(range.begin(), range.end(),
+                          detail::static_map_value_reachable<static_map<Key, T, Hash, KeyEqual>>(*this));
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+static_map<Key, T, Hash, KeyEqual>
+static_map<Key, T, Hash, KeyEqual>::createDeviceObject(device_ptr<const value_type> begin,
+                                                       device_ptr<const value_type> end)
+{
+    index_t n = static_cast<index_t>(thrust::distance(begin, end));
+
+    static_map<Key, T, Hash, KeyEqual> result;
+    result._key_equal = key_equal();
+
+    if (n == 0)
+    {
+        result._index = detail::minimal_perfect_hash<key_type, hasher, key_equal>::createDeviceObject(nullptr, 0);
+        return result;
+    }
+
+    key_type* keys          = createDeviceArray<key_type>(n);
+    index_t* input_indices  = createDeviceArray<index_t>(n);
+
+    thrust::transform(begin, end,
+                      device_begin(keys),
+                      detail::static_map_select_key<value_type>());
+
+    // Group equal keys by hashing and key equality only, and keep the first occurrence of each group
+    index_t* groups = createDeviceArray<index_t>(n);
+    detail::group_equal_keys<key_type, hasher, key_equal>(keys, n, groups);
+
+    thrust::sequence(device_begin(input_indices), device_end(input_indices));
+
+    thrust::sort(device_begin(input_indices), device_end(input_indices),
+                 detail::static_map_less_group_index(groups));
+
+    index_t unique_count = static_cast<index_t>(thrust::unique(device_begin(input_indices), device_end(input_indices),
+                                                               detail::static_map_equal_group(groups))
+                                              - device_begin(input_indices));
+
+    destroyDeviceArray<index_t>(groups);
+
+    key_type* unique_keys = createDeviceArray<key_type>(unique_count);
+
+    thrust::gather(device_begin(input_indices), device_begin(input_indices) + unique_count,
+                   device_begin(keys),
+                   device_begin(unique_keys));
+
+    result._index = detail::minimal_perfect_hash<key_type, hasher, key_equal>::createDeviceObject(unique_keys, unique_count);
+
+    if (result.size() > 0)
+    {
+        allocator_type a = result.get_allocator();  // Will be replaced by member
+        result._values = allocator_traits<allocator_type>::allocate(a, result.size());
+
+        thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(unique_count),
+                         detail::static_map_place_value<key_type, value_type, hasher, key_equal>(result._index, unique_keys, input_indices, begin.get(), result._values));
+    }
+
+    destroyDeviceArray<key_type>(keys);
+    destroyDeviceArray<key_type>(unique_keys);
+    destroyDeviceArray<index_t>(input_indices);
+
+    return result;
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+void
+static_map<Key, T, Hash, KeyEqual>::destroyDeviceObject(static_map<Key, T, Hash, KeyEqual>& device_object)
+{
+    if (device_object._values != nullptr)
+    {
+        thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(device_object.size()),
+                         detail::static_map_destroy_value<value_type>(device_object._values));
+
+        allocator_type a = device_object.get_allocator();   // Will be replaced by member
+        allocator_traits<allocator_type>::deallocate(a, device_object._values, device_object.size());
+        device_object._values = nullptr;
+    }
+
+    detail::minimal_perfect_hash<key_type, hasher, key_equal>::destroyDeviceObject(device_object._index);
+    device_object._key_equal = key_equal();
+}
+
+} // namespace stdgpu
+
+
+
+#endif // STDGPU_STATIC_MAP_DETAIL_H
@@ -0,0 +1,283 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_TASK_POOL_DETAIL_H
+#define STDGPU_TASK_POOL_DETAIL_H
+
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include <stdgpu/contract.h>
+#include <stdgpu/memory.h>
+
+
+
+namespace stdgpu
+{
+
+namespace detail
+{
+
+template <typename T>
+struct task_pool_distribute
+{
+    work_stealing_deque<T>* deques;
+    const T* values;
+    index_t n;
+    index_t worker_count;
+
+    task_pool_distribute(work_stealing_deque<T>* deques,
+                         const T* values,
+                         const index_t n,
+                         const index_t worker_count)
+        : deques(deques),
+          values(values),
+          n(n),
+          worker_count(worker_count)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t worker)
+    {
+        // Every worker fills its own deque, so it acts as the single owner
+        for (index_t i = worker; i < n; i += worker_count)
+        {
+            deques[worker].push_bottom(values[i]);
+        }
+    }
+};
+
+
+template <typename T, typename Function>
+struct task_pool_run
+{
+    task_pool<T> pool;
+    Function f;
+
+    task_pool_run(const task_pool<T>& pool,
+                  Function f)
+        : pool(pool),
+          f(f)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t worker)
+    {
+        // Spawned tasks are counted before their parent is finished, so no task is pending once the counter reaches zero
+        while (pool._pending.load() > 0)
+        {
+            thrust::pair<T, bool> task = pool.pop(worker);
+
+            if (!task.second)
+            {
+                continue;
+            }
+
+            f(task.first, pool, worker);
+
+            --pool._pending;
+        }
+    }
+};
+
+} // namespace detail
+
+
+template <typename T>
+task_pool<T>
+task_pool<T>::createDeviceObject(const index_t& worker_count,
+                                 const index_t& capacity)
+{
+    STDGPU_EXPECTS(worker_count > 0);
+    STDGPU_EXPECTS(capacity > 0);
+
+    task_pool<T> result;
+    result._worker_count = worker_count;
+    result._pending      = atomic<int>::createDeviceObject();
+
+    result._host_deques = createHostArray<deque_type>(worker_count);
+    for (index_t i = 0; i < worker_count; ++i)
+    {
+        result._host_deques[i] = deque_type::createDeviceObject(capacity);
+    }
+    result._deques      = copyCreateHost2DeviceArray<deque_type>(result._host_deques, worker_count);
+
+    return result;
+}
+
+
+template <typename T>
+void
+task_pool<T>::destroyDeviceObject(task_pool<T>& device_object)
+{
+    for (index_t i = 0; i < device_object._worker_count; ++i)
+    {
+        deque_type::destroyDeviceObject(device_object._host_deques[i]);
+    }
+
+    destroyDeviceArray<deque_type>(device_object._deques);
+    destroyHostArray<deque_type>(device_object._host_deques);
+    atomic<int>::destroyDeviceObject(device_object._pending);
+    device_object._worker_count = 0;
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY bool
+task_pool<T>::push(const index_t worker,
+                   const T& task)
+{
+    STDGPU_EXPECTS(0 <= worker);
+    STDGPU_EXPECTS(worker < worker_count());
+
+    // Count the task before it becomes visible to the thieves
+    ++_pending;
+
+    if (!_deques[worker].push_bottom(task))
+    {
+        --_pending;
+        return false;
+    }
+
+    return true;
+}
+
+
+template <typename T>
+inline bool
+task_pool<T>::push(device_ptr<const T> begin,
+                   device_ptr<const T> end)
+{
+    const index_t n = static_cast<index_t>(end - begin);
+
+    STDGPU_EXPECTS(n >= 0);
+
+    const index_t worker_share = (n + _worker_count - 1) / _worker_count;
+    for (index_t i = 0; i < _worker_count; ++i)
+    {
+        if (_host_deques[i].size() + worker_share > _host_deques[i].capacity())
+        {
+            printf("stdgpu::task_pool::push : Not enough space left for %d tasks\n", static_cast<int>(n));
+            return false;
+        }
+    }
+
+    _pending.store(_pending.load() + static_cast<int>(n));
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(_worker_count),
+                     detail::task_pool_distribute<T>(_deques, begin.get(), n, _worker_count));
+
+    return true;
+}
+
+
+template <typename T>
+template <typename Function>
+inline void
+task_pool<T>::run(Function f)
+{
+    if (empty()) return;
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(_worker_count),
+                     detail::task_pool_run<T, Function>(*this, f));
+
+    STDGPU_ENSURES(empty());
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY thrust::pair<T, bool>
+task_pool<T>::pop(const index_t worker)
+{
+    thrust::pair<T, bool> task = _deques[worker].pop_bottom();
+
+    // Sweep over the other workers starting with the neighbour, such that thieves spread over the victims
+    for (index_t i = 1; i < _worker_count && !task.second; ++i)
+    {
+        task = _deques[(worker + i) % _worker_count].steal();
+    }
+
+    return task;
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE index_t
+task_pool<T>::worker_count() const
+{
+    return _worker_count;
+}
+
+
+template <typename T>
+inline bool
+task_pool<T>::empty() const
+{
+    return (size() == 0);
+}
+
+
+template <typename T>
+inline index_t
+task_pool<T>::size() const
+{
+    return static_cast<index_t>(_pending.load());
+}
+
+
+template <typename T>
+inline void
+task_pool<T>::clear()
+{
+    for (index_t i = 0; i < _worker_count; ++i)
+    {
+        _host_deques[i].clear();
+    }
+
+    _pending.store(0);
+
+    STDGPU_ENSURES(empty());
+    STDGPU_ENSURES(valid());
+}
+
+
+template <typename T>
+inline bool
+task_pool<T>::valid() const
+{
+    index_t queued_count = 0;
+    for (index_t i = 0; i < _worker_count; ++i)
+    {
+        if (!_host_deques[i].valid())
+        {
+            return false;
+        }
+
+        queued_count += _host_deques[i].size();
+    }
+
+    // Outside of run(), every pending task is stored in one of the deques
+    return (queued_count == size());
+}
+
+} // namespace stdgpu
+
+
+
+#endif // STDGPU_TASK_POOL_DETAIL_H
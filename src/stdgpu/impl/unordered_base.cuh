@@ -16,6 +16,10 @@
 #ifndef STDGPU_UNORDERED_BASE_H
 #define STDGPU_UNORDERED_BASE_H
 
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
 #include <thrust/iterator/transform_iterator.h>
 #include <thrust/pair.h>
 
@@ -30,15 +34,103 @@
 #include <stdgpu/platform.h>
 #include <stdgpu/ranges.h>
 #include <stdgpu/vector.cuh>
+#include <stdgpu/impl/unordered_frozen_base.cuh>
 
 
 
 namespace stdgpu
 {
 
+/**
+ * \brief Occupancy and probe length statistics of an unordered container
+ */
+struct unordered_statistics
+{
+    index_t size = 0;                                   /**< The number of stored elements */
+    index_t bucket_count = 0;                           /**< The number of buckets */
+    index_t excess_count = 0;                           /**< The number of excess entries */
+    index_t empty_bucket_count = 0;                     /**< The number of buckets without any stored element */
+    float empty_bucket_ratio = 0.0f;                    /**< The fraction of buckets without any stored element */
+    index_t excess_used_count = 0;                      /**< The number of occupied excess entries */
+    float excess_used_ratio = 0.0f;                     /**< The fraction of excess entries in use */
+    index_t max_probe_length = 0;                       /**< The maximum number of entries traversed by a lookup, i.e. the longest chain including non-occupied entries */
+    float mean_probe_length = 0.0f;                     /**< The mean number of entries traversed by a successful lookup */
+    index_t erased_linked_count = 0;                    /**< The number of non-occupied entries which are still linked into a chain, e.g. erased bucket heads */
+    std::vector<index_t> chain_length_histogram = {};   /**< The number of buckets for each number of stored elements, i.e. chain_length_histogram[n] buckets contain n elements */
+};
+
+
+/**
+ * \brief The effect of compacting an unordered container
+ */
+struct unordered_compaction
+{
+    float mean_probe_length_before = 0.0f;              /**< The mean number of entries traversed by a successful lookup before the compaction */
+    float mean_probe_length_after = 0.0f;               /**< The mean number of entries traversed by a successful lookup after the compaction */
+};
+
+
+/**
+ * \brief The strategy used by the bulk lookups of unordered containers
+ */
+enum class unordered_lookup
+{
+    independent,        /**< Every key is looked up on its own */
+    interleaved         /**< Groups of keys are looked up together, prefetching the first probe of all keys in the group before resolving any of them */
+};
+
+
 namespace detail
 {
 
+/**
+ * \brief Checks whether the given functor type declares is_transparent and thus accepts heterogeneous arguments
+ * \tparam T The functor type
+ */
+template <typename T, typename = void>
+struct is_transparent : std::false_type
+{
+
+};
+
+/**
+ * \brief Checks whether the given functor type declares is_transparent and thus accepts heterogeneous arguments
+ * \tparam T The functor type
+ */
+template <typename T>
+struct is_transparent<T, typename std::conditional<true, void, typename T::is_transparent>::type> : std::true_type
+{
+
+};
+
+/**
+ * \brief Enables heterogeneous lookup with the given key-like type if both the hash and the key equality functors are transparent
+ */
+template <typename Hash, typename KeyEqual, typename KeyLike>
+using transparent_key_t = std::enable_if_t<is_transparent<Hash>::value && is_transparent<KeyEqual>::value, KeyLike>;
+
+
+/**
+ * \brief The default payload of unordered_base which does not store any additional data next to the values
+ */
+struct unordered_no_payload
+{
+    /**
+     * \brief Constructs the additional data at the given position
+     * \param[in] n The position
+     */
+    STDGPU_DEVICE_ONLY void
+    construct(const index_t n) const;
+
+    /**
+     * \brief Destroys the additional data at the given position
+     * \param[in] n The position
+     */
+    STDGPU_DEVICE_ONLY void
+    destroy(const index_t n) const;
+};
+
+
 /**
  * \brief The base class serving as the shared implementation of unordered_map and unordered_set
  * \tparam Key The key type
@@ -74,6 +166,8 @@ class unordered_base
         using iterator          = pointer;                                  /**< pointer */
         using const_iterator    = const_pointer;                            /**< const_pointer */
 
+        using frozen_type       = unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>;  /**< unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual> */
+
 
         /**
          * \brief Creates an object of this class on the GPU (device)
@@ -91,6 +185,24 @@ class unordered_base
         static void
         destroyDeviceObject(unordered_base& device_object);
 
+        /**
+         * \brief Converts the given object into a read-only snapshot with a compact layout
+         * \param[in] device_object The object allocated on the GPU (device)
+         * \return A newly created read-only snapshot holding the values of the object
+         * \post device_object is destroyed
+         */
+        static frozen_type
+        freeze(unordered_base& device_object);
+
+        /**
+         * \brief Converts the given read-only snapshot back into a mutable object
+         * \param[in] frozen_object The read-only snapshot allocated on the GPU (device)
+         * \return A newly created object with the same bucket and excess count holding the values of the snapshot
+         * \post frozen_object is destroyed
+         */
+        static unordered_base
+        thaw(frozen_type& frozen_object);
+
 
         /**
          * \brief Empty constructor
@@ -217,6 +329,138 @@ class unordered_base
         contains(const key_type& key) const;
 
 
+        /**
+         * \brief Determines if the given key is stored in the container
+         * \param[in] key The key
+         * \param[in] hash The precomputed hash of the key
+         * \pre hash == hash_function()(key)
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         */
+        STDGPU_DEVICE_ONLY iterator
+        find(const key_type& key,
+             const std::size_t hash);
+
+        /**
+         * \brief Determines if the given key is stored in the container
+         * \param[in] key The key
+         * \param[in] hash The precomputed hash of the key
+         * \pre hash == hash_function()(key)
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        find(const key_type& key,
+             const std::size_t hash) const;
+
+        /**
+         * \brief Determines if the given key is stored in the container
+         * \param[in] key The key
+         * \param[in] hash The precomputed hash of the key
+         * \pre hash == hash_function()(key)
+         * \return True if the requested key was found, false otherwise
+         */
+        STDGPU_DEVICE_ONLY bool
+        contains(const key_type& key,
+                 const std::size_t hash) const;
+
+
+        /**
+         * \brief Determines if a key equivalent to the given one is stored in the container
+         * \tparam KeyLike A type which can be hashed and compared to key_type by the transparent hasher and key_equal
+         * \param[in] key The key-like object
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         */
+        template <typename KeyLike, typename = transparent_key_t<hasher, key_equal, KeyLike>>
+        STDGPU_DEVICE_ONLY iterator
+        find(const KeyLike& key);
+
+        /**
+         * \brief Determines if a key equivalent to the given one is stored in the container
+         * \tparam KeyLike A type which can be hashed and compared to key_type by the transparent hasher and key_equal
+         * \param[in] key The key-like object
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         */
+        template <typename KeyLike, typename = transparent_key_t<hasher, key_equal, KeyLike>>
+        STDGPU_DEVICE_ONLY const_iterator
+        find(const KeyLike& key) const;
+
+        /**
+         * \brief Determines if a key equivalent to the given one is stored in the container
+         * \tparam KeyLike A type which can be hashed and compared to key_type by the transparent hasher and key_equal
+         * \param[in] key The key-like object
+         * \return True if the requested key was found, false otherwise
+         */
+        template <typename KeyLike, typename = transparent_key_t<hasher, key_equal, KeyLike>>
+        STDGPU_DEVICE_ONLY bool
+        contains(const KeyLike& key) const;
+
+        /**
+         * \brief Determines if a key equivalent to the given one is stored in the container
+         * \tparam KeyLike A type which can be hashed and compared to key_type by the transparent hasher and key_equal
+         * \param[in] key The key-like object
+         * \param[in] hash The precomputed hash of the key-like object
+         * \pre hash == hash_function()(key)
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         */
+        template <typename KeyLike, typename = transparent_key_t<hasher, key_equal, KeyLike>>
+        STDGPU_DEVICE_ONLY iterator
+        find(const KeyLike& key,
+             const std::size_t hash);
+
+        /**
+         * \brief Determines if a key equivalent to the given one is stored in the container
+         * \tparam KeyLike A type which can be hashed and compared to key_type by the transparent hasher and key_equal
+         * \param[in] key The key-like object
+         * \param[in] hash The precomputed hash of the key-like object
+         * \pre hash == hash_function()(key)
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         */
+        template <typename KeyLike, typename = transparent_key_t<hasher, key_equal, KeyLike>>
+        STDGPU_DEVICE_ONLY const_iterator
+        find(const KeyLike& key,
+             const std::size_t hash) const;
+
+        /**
+         * \brief Determines if a key equivalent to the given one is stored in the container
+         * \tparam KeyLike A type which can be hashed and compared to key_type by the transparent hasher and key_equal
+         * \param[in] key The key-like object
+         * \param[in] hash The precomputed hash of the key-like object
+         * \pre hash == hash_function()(key)
+         * \return True if the requested key was found, false otherwise
+         */
+        template <typename KeyLike, typename = transparent_key_t<hasher, key_equal, KeyLike>>
+        STDGPU_DEVICE_ONLY bool
+        contains(const KeyLike& key,
+                 const std::size_t hash) const;
+
+
+        /**
+         * \brief Determines if the given keys are stored in the container
+         * \param[in] begin The begin of the range of keys
+         * \param[in] end The end of the range of keys
+         * \param[out] result The begin of the output range storing whether the respective key was found
+         * \param[in] strategy The lookup strategy
+         */
+        void
+        contains(device_ptr<const key_type> begin,
+                 device_ptr<const key_type> end,
+                 device_ptr<bool> result,
+                 const unordered_lookup strategy = unordered_lookup::independent) const;
+
+
+        /**
+         * \brief Determines if the given keys are stored in the container
+         * \param[in] begin The begin of the range of keys
+         * \param[in] end The end of the range of keys
+         * \param[out] result The begin of the output range storing an iterator to the position of the respective key if it was found, end() otherwise
+         * \param[in] strategy The lookup strategy
+         */
+        void
+        find(device_ptr<const key_type> begin,
+             device_ptr<const key_type> end,
+             device_ptr<const_iterator> result,
+             const unordered_lookup strategy = unordered_lookup::independent) const;
+
+
         /**
          * \brief Inserts the given value into the container if possible
          * \param[in] value The new value
@@ -225,6 +469,17 @@ class unordered_base
         STDGPU_DEVICE_ONLY thrust::pair<iterator, bool>
         try_insert(const value_type& value);
 
+        /**
+         * \brief Inserts the given value into the container if possible
+         * \param[in] value The new value
+         * \param[in] payload The payload which constructs additional data at the position of the new value before it becomes visible
+         * \return An iterator to the inserted pair and true if the insertion was successful, end() and false otherwise
+         */
+        template <typename Payload>
+        STDGPU_DEVICE_ONLY thrust::pair<iterator, bool>
+        try_insert(const value_type& value,
+                   Payload payload);
+
 
         /**
          * \brief Deletes any values with the given given key from the container if possible
@@ -234,6 +489,26 @@ class unordered_base
         STDGPU_DEVICE_ONLY index_type
         try_erase(const key_type& key);
 
+        /**
+         * \brief Deletes any values with the given given key from the container if possible
+         * \param[in] key The key
+         * \param[in] payload The payload which destroys the additional data at the position of the erased value
+         * \return 1 if there was a value with key and it got erased, 0 otherwise
+         */
+        template <typename Payload>
+        STDGPU_DEVICE_ONLY index_type
+        try_erase(const key_type& key,
+                  Payload payload);
+
+
+        /**
+         * \brief Deletes the value at the given position from the container if possible
+         * \param[in] position The position of the value
+         * \return 1 if the position was occupied and the value got erased, 0 otherwise
+         */
+        STDGPU_DEVICE_ONLY index_type
+        try_erase_at(const index_t position);
+
 
         /**
          * \brief Inserts the given value into the container
@@ -253,6 +528,17 @@ class unordered_base
         STDGPU_DEVICE_ONLY thrust::pair<iterator, bool>
         insert(const value_type& value);
 
+        /**
+         * \brief Inserts the given value into the container
+         * \param[in] value The new value
+         * \param[in] payload The payload which constructs additional data at the position of the new value before it becomes visible
+         * \return An iterator to the inserted pair and true if the insertion was successful, end() and false otherwise
+         */
+        template <typename Payload>
+        STDGPU_DEVICE_ONLY thrust::pair<iterator, bool>
+        insert(const value_type& value,
+               Payload payload);
+
 
         /**
          * \brief Inserts the given range of elements into the container
@@ -274,6 +560,44 @@ class unordered_base
                device_ptr<const value_type> end);
 
 
+        /**
+         * \brief Inserts the given range of elements into the container and collects the newly inserted ones
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         * \return A range of the values which were not contained before and got inserted
+         * \note The returned range shares its buffer with device_range() and is invalidated by the next call to either function
+         */
+        device_indexed_range<const value_type>
+        insert_unique(device_ptr<value_type> begin,
+                      device_ptr<value_type> end);
+
+
+        /**
+         * \brief Inserts the given range of elements into the container and collects the newly inserted ones
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         * \return A range of the values which were not contained before and got inserted
+         * \note The returned range shares its buffer with device_range() and is invalidated by the next call to either function
+         */
+        device_indexed_range<const value_type>
+        insert_unique(device_ptr<const value_type> begin,
+                      device_ptr<const value_type> end);
+
+
+        /**
+         * \brief Inserts the given range of host elements into the container by staging them in device chunks
+         * \param[in] begin The begin of the host range
+         * \param[in] end The end of the host range
+         * \param[in] chunk_size The maximum number of elements copied to the device at once
+         * \pre chunk_size > 0
+         * \note The additional device memory is bounded by chunk_size elements instead of the size of the whole range
+         */
+        void
+        insert_from_host(host_ptr<const value_type> begin,
+                         host_ptr<const value_type> end,
+                         const index_t chunk_size = 1048576);
+
+
         /**
          * \brief Deletes the value with the given key from the container
          * \param[in] key The key
@@ -282,6 +606,17 @@ class unordered_base
         STDGPU_DEVICE_ONLY index_type
         erase(const key_type& key);
 
+        /**
+         * \brief Deletes the value with the given key from the container
+         * \param[in] key The key
+         * \param[in] payload The payload which destroys the additional data at the position of the erased value
+         * \return 1 if there was a value with key and it got erased, 0 otherwise
+         */
+        template <typename Payload>
+        STDGPU_DEVICE_ONLY index_type
+        erase(const key_type& key,
+              Payload payload);
+
 
         /**
          * \brief Deletes the values with the given range of keys from the container
@@ -303,12 +638,40 @@ class unordered_base
               device_ptr<const key_type> end);
 
 
+        /**
+         * \brief Deletes all values satisfying the given predicate from the container
+         * \param[in] pred The unary predicate called with the stored value
+         * \return The number of erased values
+         */
+        template <typename UnaryPredicate>
+        index_type
+        erase_if(UnaryPredicate pred);
+
+
+        /**
+         * \brief Moves all values of the given container whose keys are not contained in this container
+         * \param[in] source The container from which the values are extracted
+         * \note Values whose keys are already contained remain in source
+         * \pre source refers to a different object than this container
+         */
+        void
+        merge(unordered_base& source);
+
+
         /**
          * \brief Clears the complete object
          */
         void
         clear();
 
+        /**
+         * \brief Rebuilds all chains such that no erased entries remain linked and the excess entries of each bucket are stored consecutively
+         * \return The mean probe length before and after the compaction
+         * \note Must not be called concurrently with any other operation on the object
+         */
+        unordered_compaction
+        compact();
+
 
         /**
          * \brief Checks if the object is empty
@@ -362,6 +725,14 @@ class unordered_base
         max_load_factor() const;
 
 
+        /**
+         * \brief Computes occupancy and probe length statistics of the container in parallel
+         * \return The statistics of the container
+         */
+        unordered_statistics
+        statistics() const;
+
+
         /**
          * \brief The hash function
          * \return The hash function
@@ -382,6 +753,7 @@ class unordered_base
         value_type* _values = nullptr;                      /**< The values */
         index_t* _offsets = nullptr;                        /**< The offset to model linked list */
         bitset _occupied = {};                              /**< The indicator array for occupied entries */
+        std::uint8_t* _fingerprints = nullptr;              /**< The hash fingerprints of the entries, only allocated if STDGPU_USE_HASH_FINGERPRINTS is enabled */
         atomic<int> _occupied_count = {};                   /**< The number of occupied entries */
         vector<index_t> _excess_list_positions = {};        /**< The excess list positions */
         mutex_array _locks = {};                            /**< The locks used to insert and erase entries */
@@ -405,12 +777,38 @@ class unordered_base
         STDGPU_DEVICE_ONLY bool
         occupied(const index_t n) const;
 
+        template <typename KeyLike>
+        STDGPU_DEVICE_ONLY bool
+        occupied_by(const index_t n,
+                    const KeyLike& key,
+                    const std::uint8_t key_fingerprint) const;
+
+        template <typename KeyLike>
+        STDGPU_DEVICE_ONLY index_t
+        find_position(const KeyLike& key,
+                      const std::size_t hash) const;
+
+        STDGPU_DEVICE_ONLY void
+        set_fingerprint(const index_t n,
+                        const std::uint8_t key_fingerprint);
+
         STDGPU_DEVICE_ONLY index_t
         find_linked_list_end(const index_t linked_list_start);
 
         STDGPU_DEVICE_ONLY index_t
         find_previous_entry_position(const index_t entry_position,
                                      const index_t linked_list_start);
+
+        template <typename Payload>
+        STDGPU_DEVICE_ONLY void
+        erase_bucket_entry(const index_t position,
+                           Payload payload);
+
+        template <typename Payload>
+        STDGPU_DEVICE_ONLY void
+        erase_linked_list_entry(const index_t position,
+                                const index_t previous_position,
+                                Payload payload);
 };
 
 } // namespace detail
@@ -18,14 +18,17 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 
-#include <thrust/copy.h>
 #include <thrust/distance.h>
-#include <thrust/execution_policy.h>
+#include <thrust/fill.h>
 #include <thrust/for_each.h>
 #include <thrust/iterator/counting_iterator.h>
 #include <thrust/logical.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
 
+#include <stdgpu/algorithm.h>
 #include <stdgpu/bit.h>
 #include <stdgpu/config.h>
 #include <stdgpu/contract.h>
@@ -34,6 +37,7 @@
 #include <stdgpu/iterator.h>
 #include <stdgpu/memory.h>
 #include <stdgpu/utility.h>
+#include <stdgpu/impl/unordered_hash_detail.cuh>
 
 
 
@@ -43,17 +47,17 @@ namespace stdgpu
 namespace detail
 {
 
-inline index_t
-next_pow2(const index_t capacity)
+inline STDGPU_DEVICE_ONLY void
+unordered_no_payload::construct(STDGPU_MAYBE_UNUSED const index_t n) const
 {
-    STDGPU_EXPECTS(capacity > 0);
 
-    index_t result = static_cast<index_t>(1) << static_cast<index_t>(std::ceil(std::log2(capacity)));
+}
 
-    STDGPU_ENSURES(result >= capacity);
-    STDGPU_ENSURES(ispow2<std::size_t>(result));
 
-    return result;
+inline STDGPU_DEVICE_ONLY void
+unordered_no_payload::destroy(STDGPU_MAYBE_UNUSED const index_t n) const
+{
+
 }
 
 
@@ -357,6 +361,141 @@ occupied_count_valid(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqu
 }
 
 
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+struct lookup_result_contains
+{
+    STDGPU_DEVICE_ONLY bool
+    operator()(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& base,
+               typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator it) const
+    {
+        return it != base.end();
+    }
+};
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+struct lookup_result_find
+{
+    STDGPU_DEVICE_ONLY typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator
+    operator()(STDGPU_MAYBE_UNUSED const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& base,
+               typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator it) const
+    {
+        return it;
+    }
+};
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual, typename Result, typename LookupResult>
+struct lookup_independent
+{
+    unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual> base;
+    const Key* keys;
+    Result* result;
+
+    lookup_independent(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& base,
+                       const Key* keys,
+                       Result* result)
+        : base(base),
+          keys(keys),
+          result(result)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        result[i] = LookupResult()(base, base.find(keys[i]));
+    }
+};
+
+
+constexpr index_t unordered_lookup_group_size = 16;
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual, typename Result, typename LookupResult>
+struct lookup_interleaved
+{
+    unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual> base;
+    const Key* keys;
+    Result* result;
+    index_t n;
+
+    lookup_interleaved(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& base,
+                       const Key* keys,
+                       Result* result,
+                       const index_t n)
+        : base(base),
+          keys(keys),
+          result(result),
+          n(n)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t group)
+    {
+        const index_t first = group * unordered_lookup_group_size;
+        const index_t last  = stdgpu::min<index_t>(first + unordered_lookup_group_size, n);
+
+        std::size_t hashes[unordered_lookup_group_size];
+
+        // Issue the loads of the first probe for every key in the group, such that their cache misses overlap
+        for (index_t i = first; i < last; ++i)
+        {
+            std::size_t hash = base._hash(keys[i]);
+            index_t bucket = bucket_from_hash(hash, base.bucket_count());
+
+            hashes[i - first] = hash;
+
+            STDGPU_PREFETCH(&(base._values[bucket]));
+            STDGPU_PREFETCH(&(base._offsets[bucket]));
+            #if STDGPU_USE_HASH_FINGERPRINTS
+                STDGPU_PREFETCH(&(base._fingerprints[bucket]));
+            #endif
+        }
+
+        for (index_t i = first; i < last; ++i)
+        {
+            result[i] = LookupResult()(base, base.find(keys[i], hashes[i - first]));
+        }
+    }
+};
+
+
+template <typename Result, typename LookupResult, typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+void
+bulk_lookup(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& base,
+            device_ptr<const Key> begin,
+            device_ptr<const Key> end,
+            Result* result,
+            const unordered_lookup strategy)
+{
+    const index_t n = static_cast<index_t>(end - begin);
+
+    switch (strategy)
+    {
+        case unordered_lookup::interleaved :
+        {
+            const index_t groups = (n + unordered_lookup_group_size - 1) / unordered_lookup_group_size;
+
+            thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(groups),
+                             lookup_interleaved<Key, Value, KeyFromValue, Hash, KeyEqual, Result, LookupResult>(base, begin.get(), result, n));
+        }
+        break;
+
+        case unordered_lookup::independent :
+        default :
+        {
+            thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(n),
+                             lookup_independent<Key, Value, KeyFromValue, Hash, KeyEqual, Result, LookupResult>(base, begin.get(), result));
+        }
+        break;
+    }
+}
+
+
 template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
 struct insert_value
 {
@@ -376,6 +515,190 @@ struct insert_value
 };
 
 
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+struct insert_value_collect_position
+{
+    unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual> base;
+
+    insert_value_collect_position(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& base)
+        : base(base)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const Value& value)
+    {
+        thrust::pair<typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::iterator, bool> result = base.insert(value);
+
+        if (result.second)
+        {
+            base._range_indices.push_back(static_cast<index_t>(result.first - base._values));
+        }
+    }
+};
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+struct move_missing_value
+{
+    unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual> base;
+    unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual> source;
+
+    move_missing_value(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& base,
+                       const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& source)
+        : base(base),
+          source(source)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const Value& value)
+    {
+        if (base.insert(value).second)
+        {
+            source.erase(base._key_from_value(value));
+        }
+    }
+};
+
+
+template <typename Container, typename Value>
+inline STDGPU_DEVICE_ONLY void
+emit_value(Container& output,
+           const Value& value)
+{
+    output.insert(value);
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY void
+emit_value(vector<T>& output,
+           const T& value)
+{
+    output.push_back(value);
+}
+
+
+template <typename Container, typename Output>
+struct emit_value_to
+{
+    Output output;
+
+    emit_value_to(const Output& output)
+        : output(output)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const typename Container::value_type& value)
+    {
+        emit_value(output, value);
+    }
+};
+
+
+template <typename Container, typename Output, typename KeyFromValue>
+struct emit_value_if_contained
+{
+    Container probe;
+    Output output;
+    bool contained;
+
+    emit_value_if_contained(const Container& probe,
+                            const Output& output,
+                            const bool contained)
+        : probe(probe),
+          output(output),
+          contained(contained)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const typename Container::value_type& value)
+    {
+        if (probe.contains(KeyFromValue()(value)) == contained)
+        {
+            emit_value(output, value);
+        }
+    }
+};
+
+
+template <typename KeyFromValue, typename Container, typename Output>
+void
+unordered_set_union(const Container& a,
+                    const Container& b,
+                    Output& result)
+{
+    auto range_a = a.device_range();
+    thrust::for_each(range_a.begin(), range_a.end(),
+                     emit_value_to<Container, Output>(result));
+
+    // Only emit the values of b which are missing in a, such that a compacted output stays duplicate-free
+    auto range_b = b.device_range();
+    thrust::for_each(range_b.begin(), range_b.end(),
+                     emit_value_if_contained<Container, Output, KeyFromValue>(a, result, false));
+}
+
+
+template <typename KeyFromValue, typename Container, typename Output>
+void
+unordered_set_intersection(const Container& a,
+                           const Container& b,
+                           Output& result)
+{
+    auto range_a = a.device_range();
+    thrust::for_each(range_a.begin(), range_a.end(),
+                     emit_value_if_contained<Container, Output, KeyFromValue>(b, result, true));
+}
+
+
+template <typename KeyFromValue, typename Container, typename Output>
+void
+unordered_set_difference(const Container& a,
+                         const Container& b,
+                         Output& result)
+{
+    auto range_a = a.device_range();
+    thrust::for_each(range_a.begin(), range_a.end(),
+                     emit_value_if_contained<Container, Output, KeyFromValue>(b, result, false));
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual, typename UnaryPredicate>
+struct erase_matching_position
+{
+    unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual> base;
+    UnaryPredicate pred;
+
+    erase_matching_position(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& base,
+                            UnaryPredicate pred)
+        : base(base),
+          pred(pred)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        if (base.occupied(i) && pred(base._values[i]))
+        {
+            // Might fail due to contention with a neighboring entry in the same linked list, so retry
+            while (base.occupied(i))
+            {
+                base.try_erase_at(i);
+            }
+        }
+    }
+};
+
+
 template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
 struct erase_from_key
 {
@@ -414,20 +737,287 @@ struct erase_from_value
 };
 
 
+struct bucket_statistics
+{
+    index_t elements;
+    index_t excess_elements;
+    index_t probe_length;
+    index_t probe_length_sum;
+    index_t erased_linked;
+};
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+struct collect_bucket_statistics
+{
+    unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual> base;
+    bucket_statistics* statistics;
+
+    collect_bucket_statistics(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& base,
+                              bucket_statistics* statistics)
+        : base(base),
+          statistics(statistics)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        bucket_statistics result = {0, 0, 0, 0, 0};
+        index_t key_index = i;
+
+        while (true)
+        {
+            result.probe_length++;
+
+            if (base.occupied(key_index))
+            {
+                result.elements++;
+                result.probe_length_sum += result.probe_length;
+
+                if (key_index >= base.bucket_count())
+                {
+                    result.excess_elements++;
+                }
+            }
+            else if (base._offsets[key_index] != 0)
+            {
+                result.erased_linked++;
+            }
+
+            if (base._offsets[key_index] == 0)
+            {
+                break;
+            }
+
+            key_index += base._offsets[key_index];
+        }
+
+        statistics[i] = result;
+    }
+};
+
+
+struct combine_bucket_statistics
+{
+    STDGPU_HOST_DEVICE bucket_statistics
+    operator()(const bucket_statistics& lhs,
+               const bucket_statistics& rhs) const
+    {
+        bucket_statistics result;
+        result.elements         = lhs.elements + rhs.elements;
+        result.excess_elements  = lhs.excess_elements + rhs.excess_elements;
+        result.probe_length     = max(lhs.probe_length, rhs.probe_length);
+        result.probe_length_sum = lhs.probe_length_sum + rhs.probe_length_sum;
+        result.erased_linked    = lhs.erased_linked + rhs.erased_linked;
+
+        return result;
+    }
+};
+
+
+struct count_chain_lengths
+{
+    int* histogram;
+
+    count_chain_lengths(int* histogram)
+        : histogram(histogram)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const bucket_statistics& statistics)
+    {
+        stdgpu::atomic_ref<int>(histogram[statistics.elements]).fetch_add(1);
+    }
+};
+
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+struct store_bucket_size
+{
+    unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual> base;
+    index_t* bucket_sizes;
+
+    store_bucket_size(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& base,
+                      index_t* bucket_sizes)
+        : base(base),
+          bucket_sizes(bucket_sizes)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        bucket_sizes[i] = base.bucket_size(i);
+    }
+};
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+struct copy_bucket_values
+{
+    unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual> base;
+    const index_t* bucket_offsets;
+    Value* values;
+
+    copy_bucket_values(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& base,
+                       const index_t* bucket_offsets,
+                       Value* values)
+        : base(base),
+          bucket_offsets(bucket_offsets),
+          values(values)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::allocator_type a = base.get_allocator();
+
+        index_t value_index = bucket_offsets[i];
+        index_t key_index = i;
+
+        while (true)
+        {
+            if (base.occupied(key_index))
+            {
+                allocator_traits<typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::allocator_type>::construct(a, &(values[value_index]), base._values[key_index]);
+                value_index++;
+            }
+
+            if (base._offsets[key_index] == 0)
+            {
+                break;
+            }
+
+            key_index += base._offsets[key_index];
+        }
+    }
+};
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+struct destroy_occupied_value
+{
+    unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual> base;
+
+    destroy_occupied_value(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& base)
+        : base(base)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        if (base.occupied(i))
+        {
+            typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::allocator_type a = base.get_allocator();
+            allocator_traits<typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::allocator_type>::destroy(a, &(base._values[i]));
+        }
+    }
+};
+
+
+struct store_chain_excess_size
+{
+    const index_t* bucket_offsets;
+    index_t* excess_sizes;
+
+    store_chain_excess_size(const index_t* bucket_offsets,
+                            index_t* excess_sizes)
+        : bucket_offsets(bucket_offsets),
+          excess_sizes(excess_sizes)
+    {
+
+    }
+
+    STDGPU_HOST_DEVICE void
+    operator()(const index_t i)
+    {
+        // All but the first value of a bucket are stored in the excess region
+        index_t bucket_size = bucket_offsets[i + 1] - bucket_offsets[i];
+        excess_sizes[i] = (bucket_size > 0) ? bucket_size - 1 : 0;
+    }
+};
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+struct place_compact_chain
+{
+    unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual> base;
+    const index_t* bucket_offsets;
+    const index_t* excess_offsets;
+    const Value* values;
+
+    place_compact_chain(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& base,
+                        const index_t* bucket_offsets,
+                        const index_t* excess_offsets,
+                        const Value* values)
+        : base(base),
+          bucket_offsets(bucket_offsets),
+          excess_offsets(excess_offsets),
+          values(values)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::allocator_type a = base.get_allocator();
+
+        index_t previous_index = i;
+        for (index_t value_index = bucket_offsets[i]; value_index < bucket_offsets[i + 1]; ++value_index)
+        {
+            // The first value becomes the bucket head, the remaining ones are stored consecutively in the excess region
+            index_t key_index = (value_index == bucket_offsets[i]) ? i : base.bucket_count() + excess_offsets[i] + (value_index - bucket_offsets[i] - 1);
+
+            allocator_traits<typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::allocator_type>::construct(a, &(base._values[key_index]), values[value_index]);
+            base.set_fingerprint(key_index, fingerprint_from_hash(base._hash(base._key_from_value(values[value_index]))));
+            base._occupied.set(key_index);
+
+            if (key_index != i)
+            {
+                base._offsets[previous_index] = key_index - previous_index;
+            }
+            previous_index = key_index;
+        }
+    }
+};
+
+
+template <typename Value>
+struct destroy_compact_value
+{
+    Value* values;
+
+    destroy_compact_value(Value* values)
+        : values(values)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        safe_device_allocator<Value> a;
+        allocator_traits<safe_device_allocator<Value>>::destroy(a, &(values[i]));
+    }
+};
+
+
 template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
 inline STDGPU_HOST_DEVICE index_t
 unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::bucket(const key_type& key) const
 {
-    #if STDGPU_USE_FIBONACCI_HASHING
-        // If bucket_count() == 1, then the result will be shifted by the width of std::size_t which leads to undefined/unreliable behavior
-        std::size_t result = (bucket_count() == 1) ? 0 : (_hash(key) * 11400714819323198485llu) >> (numeric_limits<std::size_t>::digits - log2pow2<std::size_t>(bucket_count()));
-    #else
-        std::size_t result = mod2<std::size_t>(_hash(key), bucket_count());
-    #endif
-
-    STDGPU_ENSURES(0 <= static_cast<index_t>(result));
-    STDGPU_ENSURES(static_cast<index_t>(result) < bucket_count());
-    return result;
+    return bucket_from_hash(_hash(key), bucket_count());
 }
 
 
@@ -473,48 +1063,155 @@ template <typename Key, typename Value, typename KeyFromValue, typename Hash, ty
 inline STDGPU_DEVICE_ONLY typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::iterator
 unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::find(const key_type& key)
 {
-    index_t key_index = bucket(key);
+    return find(key, _hash(key));
+}
 
-    // Bucket
-    if (occupied(key_index)
-     && _key_equal(_key_from_value(_values[key_index]), key))
-    {
-        STDGPU_ENSURES(0 <= key_index);
-        STDGPU_ENSURES(key_index < total_count());
-        return _values + key_index;
-    }
 
-    // Linked list
-    while (_offsets[key_index] != 0)
-    {
-        key_index += _offsets[key_index];
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::find(const key_type& key) const
+{
+    return find(key, _hash(key));
+}
 
-        if (occupied(key_index)
-         && _key_equal(_key_from_value(_values[key_index]), key))
-        {
-            STDGPU_ENSURES(0 <= key_index);
-            STDGPU_ENSURES(key_index < total_count());
-            return _values + key_index;
-        }
-    }
 
-    return end();
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY bool
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::contains(const key_type& key) const
+{
+    return find(key) != end();
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::iterator
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::find(const key_type& key,
+                                                               const std::size_t hash)
+{
+    STDGPU_EXPECTS(hash == _hash(key));
+
+    return _values + find_position(key, hash);
 }
 
 
 template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
 inline STDGPU_DEVICE_ONLY typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator
-unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::find(const key_type& key) const
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::find(const key_type& key,
+                                                               const std::size_t hash) const
+{
+    STDGPU_EXPECTS(hash == _hash(key));
+
+    return _values + find_position(key, hash);
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY bool
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::contains(const key_type& key,
+                                                                   const std::size_t hash) const
+{
+    return find(key, hash) != end();
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::iterator
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::find(const KeyLike& key)
+{
+    return find(key, _hash(key));
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::find(const KeyLike& key) const
+{
+    return find(key, _hash(key));
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY bool
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::contains(const KeyLike& key) const
+{
+    return find(key) != end();
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::iterator
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::find(const KeyLike& key,
+                                                               const std::size_t hash)
+{
+    STDGPU_EXPECTS(hash == _hash(key));
+
+    return _values + find_position(key, hash);
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::find(const KeyLike& key,
+                                                               const std::size_t hash) const
+{
+    STDGPU_EXPECTS(hash == _hash(key));
+
+    return _values + find_position(key, hash);
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY bool
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::contains(const KeyLike& key,
+                                                                   const std::size_t hash) const
+{
+    return find(key, hash) != end();
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline void
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::contains(device_ptr<const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::key_type> begin,
+                                                                   device_ptr<const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::key_type> end,
+                                                                   device_ptr<bool> result,
+                                                                   const unordered_lookup strategy) const
+{
+    bulk_lookup<bool, lookup_result_contains<Key, Value, KeyFromValue, Hash, KeyEqual>>(*this, begin, end, result.get(), strategy);
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline void
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::find(device_ptr<const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::key_type> begin,
+                                                               device_ptr<const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::key_type> end,
+                                                               device_ptr<unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator> result,
+                                                               const unordered_lookup strategy) const
+{
+    bulk_lookup<const_iterator, lookup_result_find<Key, Value, KeyFromValue, Hash, KeyEqual>>(*this, begin, end, result.get(), strategy);
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+template <typename KeyLike>
+inline STDGPU_DEVICE_ONLY index_t
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::find_position(const KeyLike& key,
+                                                                        const std::size_t hash) const
 {
-    index_t key_index = bucket(key);
+    index_t key_index = bucket_from_hash(hash, bucket_count());
+    std::uint8_t key_fingerprint = fingerprint_from_hash(hash);
 
     // Bucket
-    if (occupied(key_index)
-     && _key_equal(_key_from_value(_values[key_index]), key))
+    if (occupied_by(key_index, key, key_fingerprint))
     {
         STDGPU_ENSURES(0 <= key_index);
         STDGPU_ENSURES(key_index < total_count());
-        return _values + key_index;
+        return key_index;
     }
 
     // Linked list
@@ -522,35 +1219,37 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::find(const key_type& k
     {
         key_index += _offsets[key_index];
 
-        if (occupied(key_index)
-         && _key_equal(_key_from_value(_values[key_index]), key))
+        if (occupied_by(key_index, key, key_fingerprint))
         {
             STDGPU_ENSURES(0 <= key_index);
             STDGPU_ENSURES(key_index < total_count());
-            return _values + key_index;
+            return key_index;
         }
     }
 
-    return end();
+    return total_count();
 }
 
 
 template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
-inline STDGPU_DEVICE_ONLY bool
-unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::contains(const key_type& key) const
+inline STDGPU_DEVICE_ONLY thrust::pair<typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::iterator, bool>
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::try_insert(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::value_type& value)
 {
-    return find(key) != end();
+    return try_insert(value, unordered_no_payload());
 }
 
 
 template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+template <typename Payload>
 inline STDGPU_DEVICE_ONLY thrust::pair<typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::iterator, bool>
-unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::try_insert(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::value_type& value)
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::try_insert(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::value_type& value,
+                                                                     Payload payload)
 {
     iterator inserted_it = end();
     bool inserted = false;
 
     key_type block = _key_from_value(value);
+    std::uint8_t block_fingerprint = fingerprint_from_hash(_hash(block));
 
     if (!contains(block))
     {
@@ -568,6 +1267,8 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::try_insert(const unord
                 {
                     allocator_type a = get_allocator();     // Will be replaced by member
                     allocator_traits<allocator_type>::construct(a, &(_values[bucket_index]), value);
+                    set_fingerprint(bucket_index, block_fingerprint);
+                    payload.construct(bucket_index);
                     // Do not touch the linked list
                     //_offsets[bucket_index] = 0;
 
@@ -613,6 +1314,8 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::try_insert(const unord
 
                         allocator_type a = get_allocator();     // Will be replaced by member
                         allocator_traits<allocator_type>::construct(a, &(_values[new_linked_list_end]), value);
+                        set_fingerprint(new_linked_list_end, block_fingerprint);
+                        payload.construct(new_linked_list_end);
                         _offsets[new_linked_list_end] = 0;
 
                         // Set occupied status after entry has been fully constructed
@@ -645,6 +1348,16 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::try_insert(const unord
 template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
 inline STDGPU_DEVICE_ONLY index_t
 unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::try_erase(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::key_type& key)
+{
+    return try_erase(key, unordered_no_payload());
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+template <typename Payload>
+inline STDGPU_DEVICE_ONLY index_t
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::try_erase(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::key_type& key,
+                                                                    Payload payload)
 {
     bool erased = false;
 
@@ -667,22 +1380,9 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::try_erase(const unorde
                 const_iterator checked_it = find(key);
                 if (it == checked_it)
                 {
-                    // Set not-occupied status before entry has been fully erased
-                    bool was_occupied = _occupied.reset(position);
-                    --_occupied_count;
-
-                    // Default values
-                    allocator_type a = get_allocator();     // Will be replaced by member
-                    allocator_traits<allocator_type>::destroy(a, &(_values[position]));
-                    // Do not touch the linked list
-                    //_offsets[position] = 0;
+                    erase_bucket_entry(position, payload);
 
                     erased = true;
-
-                    if (!was_occupied)
-                    {
-                        printf("unordered_base::try_erase : Expected entry to be occupied but actually was not\n");
-                    }
                 }
 
                 //  END  --- critical section ---  END
@@ -704,40 +1404,79 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::try_erase(const unorde
                 if (it == checked_it
                  && previous_position == checked_previous_position)
                 {
-                    // Set offset
-                    if (_offsets[position] != 0)
-                    {
-                        _offsets[previous_position] += _offsets[position];
-                    }
-                    else
-                    {
-                        _offsets[previous_position] = 0;
-                    }
+                    erase_linked_list_entry(position, previous_position, payload);
 
-                    // Set not-occupied status before entry has been fully erased
-                    bool was_occupied = _occupied.reset(position);
-                    --_occupied_count;
+                    erased = true;
+                }
 
-                    // Default values
-                    allocator_type a = get_allocator();     // Will be replaced by member
-                    allocator_traits<allocator_type>::destroy(a, &(_values[position]));
-                    // Do not reset the offset of the erased linked list entry as another thread executing find() might still need it, so make try_insert responsible for resetting it
-                    //_offsets[position] = 0;
-                    _excess_list_positions.push_back(position);
+                //  END  --- critical section ---  END
+                _locks[position].unlock();
+                _locks[previous_position].unlock();
+            }
+
+        }
+    }
+
+    return static_cast<index_t>(erased);
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY index_t
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::try_erase_at(const index_t position)
+{
+    STDGPU_EXPECTS(0 <= position);
+    STDGPU_EXPECTS(position < total_count());
+
+    bool erased = false;
+
+    if (occupied(position))
+    {
+        // Only hash the stored key to locate the bucket, the chain does not need to be searched for the key
+        index_t bucket_index = bucket(_key_from_value(_values[position]));
+
+        // Bucket
+        if (position == bucket_index)
+        {
+            if (_locks[position].try_lock())
+            {
+                // START --- critical section --- START
+
+                // !!! VERIFY CONDITIONS HAVE NOT CHANGED !!!
+                if (occupied(position))
+                {
+                    erase_bucket_entry(position, unordered_no_payload());
 
                     erased = true;
+                }
 
-                    if (!was_occupied)
-                    {
-                        printf("unordered_base::try_erase : Expected entry to be occupied but actually was not\n");
-                    }
+                //  END  --- critical section ---  END
+                _locks[position].unlock();
+            }
+        }
+        // Linked list
+        else
+        {
+            index_t previous_position = find_previous_entry_position(position, bucket_index);
+
+            if (try_lock(_locks[position], _locks[previous_position]) == -1)
+            {
+                // START --- critical section --- START
+
+                // !!! VERIFY CONDITIONS HAVE NOT CHANGED !!!
+                index_t checked_previous_position = find_previous_entry_position(position, bucket_index);
+                if (occupied(position)
+                 && previous_position == checked_previous_position)
+                {
+                    erase_linked_list_entry(position, previous_position, unordered_no_payload());
+
+                    erased = true;
                 }
 
                 //  END  --- critical section ---  END
                 _locks[position].unlock();
                 _locks[previous_position].unlock();
             }
-
         }
     }
 
@@ -745,6 +1484,66 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::try_erase(const unorde
 }
 
 
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+template <typename Payload>
+inline STDGPU_DEVICE_ONLY void
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::erase_bucket_entry(const index_t position,
+                                                                             Payload payload)
+{
+    // Set not-occupied status before entry has been fully erased
+    bool was_occupied = _occupied.reset(position);
+    --_occupied_count;
+
+    // Default values
+    allocator_type a = get_allocator();     // Will be replaced by member
+    allocator_traits<allocator_type>::destroy(a, &(_values[position]));
+    payload.destroy(position);
+    // Do not touch the linked list
+    //_offsets[position] = 0;
+
+    if (!was_occupied)
+    {
+        printf("unordered_base::try_erase : Expected entry to be occupied but actually was not\n");
+    }
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+template <typename Payload>
+inline STDGPU_DEVICE_ONLY void
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::erase_linked_list_entry(const index_t position,
+                                                                                  const index_t previous_position,
+                                                                                  Payload payload)
+{
+    // Set offset
+    if (_offsets[position] != 0)
+    {
+        _offsets[previous_position] += _offsets[position];
+    }
+    else
+    {
+        _offsets[previous_position] = 0;
+    }
+
+    // Set not-occupied status before entry has been fully erased
+    bool was_occupied = _occupied.reset(position);
+    --_occupied_count;
+
+    // Default values
+    allocator_type a = get_allocator();     // Will be replaced by member
+    allocator_traits<allocator_type>::destroy(a, &(_values[position]));
+    payload.destroy(position);
+    // Do not reset the offset of the erased linked list entry as another thread executing find() might still need it, so make try_insert responsible for resetting it
+    //_offsets[position] = 0;
+    _excess_list_positions.push_back(position);
+
+    if (!was_occupied)
+    {
+        printf("unordered_base::try_erase : Expected entry to be occupied but actually was not\n");
+    }
+}
+
+
 template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
 inline STDGPU_DEVICE_ONLY index_t
 unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::find_linked_list_end(const index_t linked_list_start)
@@ -802,6 +1601,16 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::emplace(Args&&... args
 template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
 inline STDGPU_DEVICE_ONLY thrust::pair<typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::iterator, bool>
 unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::insert(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::value_type& value)
+{
+    return insert(value, unordered_no_payload());
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+template <typename Payload>
+inline STDGPU_DEVICE_ONLY thrust::pair<typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::iterator, bool>
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::insert(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::value_type& value,
+                                                                 Payload payload)
 {
     thrust::pair<iterator, bool> result = thrust::make_pair(end(), false);
 
@@ -810,7 +1619,7 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::insert(const unordered
         if (!contains(_key_from_value(value))
             && !full() && !_excess_list_positions.empty())
         {
-            result = try_insert(value);
+            result = try_insert(value, payload);
         }
         else
         {
@@ -842,9 +1651,78 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::insert(device_ptr<cons
 }
 
 
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline device_indexed_range<const typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::value_type>
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::insert_unique(device_ptr<unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::value_type> begin,
+                                                                        device_ptr<unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::value_type> end)
+{
+    _range_indices.clear();
+
+    thrust::for_each(begin, end,
+                     insert_value_collect_position<Key, Value, KeyFromValue, Hash, KeyEqual>(*this));
+
+    return device_indexed_range<const value_type>(_range_indices.device_range(), _values);
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline device_indexed_range<const typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::value_type>
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::insert_unique(device_ptr<const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::value_type> begin,
+                                                                        device_ptr<const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::value_type> end)
+{
+    _range_indices.clear();
+
+    thrust::for_each(begin, end,
+                     insert_value_collect_position<Key, Value, KeyFromValue, Hash, KeyEqual>(*this));
+
+    return device_indexed_range<const value_type>(_range_indices.device_range(), _values);
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline void
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::insert_from_host(host_ptr<const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::value_type> begin,
+                                                                           host_ptr<const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::value_type> end,
+                                                                           const index_t chunk_size)
+{
+    STDGPU_EXPECTS(chunk_size > 0);
+
+    const index_t n = static_cast<index_t>(end - begin);
+    if (n == 0)
+    {
+        return;
+    }
+
+    // The staging buffer is reused for every chunk, so only chunk_size elements reside on the device at once
+    const index_t staging_size = std::min(n, chunk_size);
+    value_type* staging = createDeviceArray<value_type>(staging_size);
+
+    for (index_t offset = 0; offset < n; offset += staging_size)
+    {
+        const index_t count = std::min(staging_size, n - offset);
+
+        copyHost2DeviceArray<value_type>(begin.get() + offset, count, staging, MemoryCopy::NO_CHECK);
+
+        insert(device_cbegin(staging), device_cbegin(staging) + count);
+    }
+
+    destroyDeviceArray<value_type>(staging);
+}
+
+
 template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
 inline STDGPU_DEVICE_ONLY index_t
 unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::erase(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::key_type& key)
+{
+    return erase(key, unordered_no_payload());
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+template <typename Payload>
+inline STDGPU_DEVICE_ONLY index_t
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::erase(const unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::key_type& key,
+                                                                Payload payload)
 {
     index_t result = 0;
 
@@ -852,7 +1730,7 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::erase(const unordered_
     {
         if (contains(key))
         {
-            result = try_erase(key);
+            result = try_erase(key, payload);
         }
         else
         {
@@ -895,6 +1773,65 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::occupied(const index_t
 }
 
 
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+template <typename KeyLike>
+inline STDGPU_DEVICE_ONLY bool
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::occupied_by(const index_t n,
+                                                                      const KeyLike& key,
+                                                                      STDGPU_MAYBE_UNUSED const std::uint8_t key_fingerprint) const
+{
+    if (!occupied(n))
+    {
+        return false;
+    }
+
+    #if STDGPU_USE_HASH_FINGERPRINTS
+        // Reject most mismatching entries using the metadata only without loading the value
+        if (_fingerprints[n] != key_fingerprint)
+        {
+            return false;
+        }
+    #endif
+
+    return _key_equal(_key_from_value(_values[n]), key);
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY void
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::set_fingerprint(STDGPU_MAYBE_UNUSED const index_t n,
+                                                                          STDGPU_MAYBE_UNUSED const std::uint8_t key_fingerprint)
+{
+    #if STDGPU_USE_HASH_FINGERPRINTS
+        _fingerprints[n] = key_fingerprint;
+    #endif
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+template <typename UnaryPredicate>
+inline index_t
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::erase_if(UnaryPredicate pred)
+{
+    index_t old_size = size();
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(total_count()),
+                     erase_matching_position<Key, Value, KeyFromValue, Hash, KeyEqual, UnaryPredicate>(*this, pred));
+
+    return old_size - size();
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline void
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::merge(unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& source)
+{
+    auto range = source.device_range();
+    thrust::for_each(range.begin(), range.end(),
+                     move_missing_value<Key, Value, KeyFromValue, Hash, KeyEqual>(*this, source));
+}
+
+
 template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
 inline STDGPU_HOST_DEVICE bool
 unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::empty() const
@@ -971,6 +1908,60 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::max_load_factor() cons
 }
 
 
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+unordered_statistics
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::statistics() const
+{
+    unordered_statistics result;
+    result.size         = size();
+    result.bucket_count = bucket_count();
+    result.excess_count = excess_count();
+
+    // Special case : Zero capacity has no chains
+    if (bucket_count() == 0) return result;
+
+
+    bucket_statistics* statistics = createDeviceArray<bucket_statistics>(bucket_count(), {0, 0, 0, 0, 0});
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(bucket_count()),
+                     collect_bucket_statistics<Key, Value, KeyFromValue, Hash, KeyEqual>(*this, statistics));
+
+    bucket_statistics total = thrust::reduce(device_cbegin(statistics), device_cend(statistics),
+                                             bucket_statistics{0, 0, 0, 0, 0},
+                                             combine_bucket_statistics());
+
+    index_t histogram_size = total.probe_length + 1;
+    int* histogram = createDeviceArray<int>(histogram_size, 0);
+
+    thrust::for_each(device_cbegin(statistics), device_cend(statistics),
+                     count_chain_lengths(histogram));
+
+    int* host_histogram = copyCreateDevice2HostArray<int>(histogram, histogram_size);
+
+    result.chain_length_histogram = std::vector<index_t>(host_histogram, host_histogram + histogram_size);
+    while (result.chain_length_histogram.size() > 1 && result.chain_length_histogram.back() == 0)
+    {
+        result.chain_length_histogram.pop_back();
+    }
+
+    result.empty_bucket_count   = result.chain_length_histogram[0];
+    result.empty_bucket_ratio   = static_cast<float>(result.empty_bucket_count) / static_cast<float>(bucket_count());
+    result.excess_used_count    = total.excess_elements;
+    result.excess_used_ratio    = (excess_count() > 0) ? static_cast<float>(total.excess_elements) / static_cast<float>(excess_count()) : 0.0f;
+    result.max_probe_length     = total.probe_length;
+    result.mean_probe_length    = (total.elements > 0) ? static_cast<float>(total.probe_length_sum) / static_cast<float>(total.elements) : 0.0f;
+    result.erased_linked_count  = total.erased_linked;
+
+    destroyHostArray<int>(host_histogram);
+    destroyDeviceArray<int>(histogram);
+    destroyDeviceArray<bucket_statistics>(statistics);
+
+    STDGPU_ENSURES(total.elements == size());
+
+    return result;
+}
+
+
 template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
 inline STDGPU_HOST_DEVICE typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::hasher
 unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::hash_function() const
@@ -1015,6 +2006,75 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::clear()
 }
 
 
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+unordered_compaction
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::compact()
+{
+    unordered_compaction result;
+    result.mean_probe_length_before = statistics().mean_probe_length;
+
+    index_t n = size();
+
+    // Gather the values of each bucket contiguously, the additional last offset becomes the total size
+    index_t* bucket_offsets = createDeviceArray<index_t>(bucket_count() + 1, 0);
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(bucket_count()),
+                     store_bucket_size<Key, Value, KeyFromValue, Hash, KeyEqual>(*this, bucket_offsets));
+
+    thrust::exclusive_scan(device_begin(bucket_offsets), device_end(bucket_offsets),
+                           device_begin(bucket_offsets));
+
+    allocator_type a = get_allocator();     // Will be replaced by member
+    value_type* values = (n > 0) ? allocator_traits<allocator_type>::allocate(a, n) : nullptr;
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(bucket_count()),
+                     copy_bucket_values<Key, Value, KeyFromValue, Hash, KeyEqual>(*this, bucket_offsets, values));
+
+    // Reset the complete state including the links of erased entries
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(total_count()),
+                     destroy_occupied_value<Key, Value, KeyFromValue, Hash, KeyEqual>(*this));
+
+    _occupied.reset();
+    thrust::fill(device_begin(_offsets), device_end(_offsets),
+                 0);
+
+    // Rebuild the chains with the excess entries of each bucket laid out consecutively
+    index_t* excess_offsets = createDeviceArray<index_t>(bucket_count() + 1, 0);
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(bucket_count()),
+                     store_chain_excess_size(bucket_offsets, excess_offsets));
+
+    thrust::exclusive_scan(device_begin(excess_offsets), device_end(excess_offsets),
+                           device_begin(excess_offsets));
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(bucket_count()),
+                     place_compact_chain<Key, Value, KeyFromValue, Hash, KeyEqual>(*this, bucket_offsets, excess_offsets, values));
+
+    _occupied_count.store(static_cast<int>(n));
+
+    index_t excess_used;
+    copyDevice2HostArray<index_t>(excess_offsets + bucket_count(), 1, &excess_used, MemoryCopy::NO_CHECK);
+
+    STDGPU_ENSURES(excess_used <= excess_count());
+
+    _excess_list_positions.assign(thrust::counting_iterator<index_t>(bucket_count() + excess_used), thrust::counting_iterator<index_t>(total_count()));
+
+    if (values != nullptr)
+    {
+        thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(n),
+                         destroy_compact_value<value_type>(values));
+
+        allocator_traits<allocator_type>::deallocate(a, values, n);
+    }
+    destroyDeviceArray<index_t>(excess_offsets);
+    destroyDeviceArray<index_t>(bucket_offsets);
+
+    result.mean_probe_length_after = statistics().mean_probe_length;
+
+    return result;
+}
+
+
 template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
 unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>
 unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::createDeviceObject(const index_t& capacity)
@@ -1036,6 +2096,9 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::createDeviceObject(con
     result._values                  = allocator_traits<allocator_type>::allocate(a, total_count);
     result._offsets                 = createDeviceArray<index_t>(total_count, 0);
     result._occupied                = bitset::createDeviceObject(total_count);
+    #if STDGPU_USE_HASH_FINGERPRINTS
+        result._fingerprints        = createDeviceArray<std::uint8_t>(total_count, 0);
+    #endif
     result._occupied_count          = atomic<int>::createDeviceObject();
     result._locks                   = mutex_array::createDeviceObject(total_count);
     result._excess_list_positions   = vector<index_t>::createDeviceObject(excess_count);
@@ -1045,9 +2108,7 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::createDeviceObject(con
 
     result._range_indices           = vector<index_t>::createDeviceObject(total_count);
 
-    thrust::copy(thrust::device,
-                 thrust::counting_iterator<index_t>(bucket_count), thrust::counting_iterator<index_t>(bucket_count + excess_count),
-                 stdgpu::back_inserter(result._excess_list_positions));
+    result._excess_list_positions.append(thrust::counting_iterator<index_t>(bucket_count), thrust::counting_iterator<index_t>(bucket_count + excess_count));
 
     STDGPU_ENSURES(result._excess_list_positions.full());
 
@@ -1073,6 +2134,9 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::createDeviceObject(con
     result._values                  = allocator_traits<allocator_type>::allocate(a, total_count);
     result._offsets                 = createDeviceArray<index_t>(total_count, 0);
     result._occupied                = bitset::createDeviceObject(total_count);
+    #if STDGPU_USE_HASH_FINGERPRINTS
+        result._fingerprints        = createDeviceArray<std::uint8_t>(total_count, 0);
+    #endif
     result._occupied_count          = atomic<int>::createDeviceObject();
     result._locks                   = mutex_array::createDeviceObject(total_count);
     result._excess_list_positions   = vector<index_t>::createDeviceObject(excess_count);
@@ -1082,9 +2146,7 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::createDeviceObject(con
 
     result._range_indices           = vector<index_t>::createDeviceObject(total_count);
 
-    thrust::copy(thrust::device,
-                 thrust::counting_iterator<index_t>(bucket_count), thrust::counting_iterator<index_t>(bucket_count + excess_count),
-                 stdgpu::back_inserter(result._excess_list_positions));
+    result._excess_list_positions.append(thrust::counting_iterator<index_t>(bucket_count), thrust::counting_iterator<index_t>(bucket_count + excess_count));
 
     STDGPU_ENSURES(result._excess_list_positions.full());
 
@@ -1092,6 +2154,57 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::createDeviceObject(con
 }
 
 
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+typename unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::frozen_type
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::freeze(unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& device_object)
+{
+    frozen_type result;
+    allocator_type a = device_object.get_allocator();   // Will be replaced by member
+    result._bucket_count    = device_object.bucket_count();
+    result._excess_count    = device_object.excess_count();
+    result._size            = device_object.size();
+    result._values          = (result._size > 0) ? allocator_traits<allocator_type>::allocate(a, result._size) : nullptr;
+    result._bucket_offsets  = createDeviceArray<index_t>(result._bucket_count + 1, 0);
+    result._key_from_value  = device_object._key_from_value;
+    result._hash            = device_object._hash;
+    result._key_equal       = device_object._key_equal;
+
+    // Bucket sizes are turned into bucket offsets in-place, the additional last entry becomes the total size
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(result._bucket_count),
+                     store_bucket_size<Key, Value, KeyFromValue, Hash, KeyEqual>(device_object, result._bucket_offsets));
+
+    thrust::exclusive_scan(device_begin(result._bucket_offsets), device_end(result._bucket_offsets),
+                           device_begin(result._bucket_offsets));
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(result._bucket_count),
+                     copy_bucket_values<Key, Value, KeyFromValue, Hash, KeyEqual>(device_object, result._bucket_offsets, result._values));
+
+    destroyDeviceObject(device_object);
+
+    return result;
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>
+unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::thaw(frozen_type& frozen_object)
+{
+    unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual> result = createDeviceObject(frozen_object._bucket_count, frozen_object._excess_count);
+    result._key_from_value  = frozen_object._key_from_value;
+    result._hash            = frozen_object._hash;
+    result._key_equal       = frozen_object._key_equal;
+
+    result.insert(make_device(static_cast<const value_type*>(frozen_object._values)),
+                  make_device(static_cast<const value_type*>(frozen_object._values)) + frozen_object.size());
+
+    STDGPU_ENSURES(result.size() == frozen_object.size());
+
+    frozen_type::destroyDeviceObject(frozen_object);
+
+    return result;
+}
+
+
 template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
 void
 unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::destroyDeviceObject(unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>& device_object)
@@ -1106,6 +2219,10 @@ unordered_base<Key, Value, KeyFromValue, Hash, KeyEqual>::destroyDeviceObject(un
     device_object._excess_count = 0;
     destroyDeviceArray<index_t>(device_object._offsets);
     bitset::destroyDeviceObject(device_object._occupied);
+    if (device_object._fingerprints != nullptr)
+    {
+        destroyDeviceArray<std::uint8_t>(device_object._fingerprints);
+    }
     atomic<int>::destroyDeviceObject(device_object._occupied_count);
     mutex_array::destroyDeviceObject(device_object._locks);
     vector<index_t>::destroyDeviceObject(device_object._excess_list_positions);
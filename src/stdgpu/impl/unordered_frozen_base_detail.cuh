@@ -0,0 +1,503 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_UNORDERED_FROZEN_BASE_DETAIL_H
+#define STDGPU_UNORDERED_FROZEN_BASE_DETAIL_H
+
+#include <thrust/distance.h>
+#include <thrust/for_each.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/logical.h>
+#include <thrust/scan.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+
+#include <stdgpu/atomic.cuh>
+#include <stdgpu/contract.h>
+#include <stdgpu/iterator.h>
+#include <stdgpu/memory.h>
+#include <stdgpu/impl/unordered_hash_detail.cuh>
+
+
+
+namespace stdgpu
+{
+
+namespace detail
+{
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+class unordered_base;
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::allocator_type
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::get_allocator() const
+{
+    return allocator_type();
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::begin() const
+{
+    return _values;
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::cbegin() const
+{
+    return begin();
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::end() const
+{
+    return _values + size();
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::cend() const
+{
+    return end();
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+stdgpu::device_range<const typename unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::value_type>
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::device_range() const
+{
+    return stdgpu::device_range<const value_type>(_values, size());
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::bucket(const key_type& key) const
+{
+    return bucket_from_hash(_hash(key), bucket_count());
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY index_t
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::bucket_size(index_type n) const
+{
+    STDGPU_EXPECTS(n < bucket_count());
+
+    return _bucket_offsets[n + 1] - _bucket_offsets[n];
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY index_t
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::count(const key_type& key) const
+{
+    thrust::pair<const_iterator, const_iterator> range = equal_range(key);
+
+    return static_cast<index_t>(range.second - range.first);
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY thrust::pair<typename unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator, typename unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator>
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::equal_range(const key_type& key) const
+{
+    const_iterator first = find(key);
+
+    if (first == end())
+    {
+        return thrust::pair<const_iterator, const_iterator>(end(), end());
+    }
+
+    // Values with equal keys are stored contiguously inside their bucket
+    const_iterator bucket_end = _values + _bucket_offsets[bucket(key) + 1];
+    const_iterator last = first + 1;
+    while (last != bucket_end && _key_equal(_key_from_value(*last), key))
+    {
+        ++last;
+    }
+
+    return thrust::pair<const_iterator, const_iterator>(first, last);
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::find(const key_type& key) const
+{
+    // Special case : Zero buckets cannot hold any value
+    if (bucket_count() == 0) return end();
+
+    index_t bucket_index = bucket(key);
+
+    index_t bucket_end = _bucket_offsets[bucket_index + 1];
+    for (index_t key_index = _bucket_offsets[bucket_index]; key_index < bucket_end; ++key_index)
+    {
+        if (_key_equal(_key_from_value(_values[key_index]), key))
+        {
+            STDGPU_ENSURES(0 <= key_index);
+            STDGPU_ENSURES(key_index < size());
+            return _values + key_index;
+        }
+    }
+
+    return end();
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY bool
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::contains(const key_type& key) const
+{
+    return find(key) != end();
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE bool
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::empty() const
+{
+    return (size() == 0);
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::size() const
+{
+    return _size;
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::bucket_count() const
+{
+    return _bucket_count;
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::hasher
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::hash_function() const
+{
+    return _hash;
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::key_equal
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::key_eq() const
+{
+    return _key_equal;
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+struct frozen_value_reachable
+{
+    unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual> base;
+
+    frozen_value_reachable(const unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>& base)
+        : base(base)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY bool
+    operator()(const index_t i) const
+    {
+        thrust::pair<typename unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator,
+                     typename unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::const_iterator> range = base.equal_range(base._key_from_value(base._values[i]));
+
+        if (!(range.first <= base._values + i && base._values + i < range.second))
+        {
+            printf("stdgpu::detail::unordered_frozen_base : Value %d not reachable by its key\n", static_cast<int>(i));
+            return false;
+        }
+
+        return true;
+    }
+};
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+bool
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::valid() const
+{
+    return thrust::all_of(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(size()),
+                          frozen_value_reachable<Key, Value, KeyFromValue, Hash, KeyEqual>(*this));
+}
+
+
+template <typename Key, typename Hash>
+struct count_key_bucket
+{
+    const Key* keys;
+    index_t* buckets;
+    int* bucket_sizes;
+    index_t bucket_count;
+    Hash hash;
+
+    count_key_bucket(const Key* keys,
+                     index_t* buckets,
+                     int* bucket_sizes,
+                     const index_t bucket_count,
+                     const Hash& hash)
+        : keys(keys),
+          buckets(buckets),
+          bucket_sizes(bucket_sizes),
+          bucket_count(bucket_count),
+          hash(hash)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        buckets[i] = bucket_from_hash(hash(keys[i]), bucket_count);
+
+        stdgpu::atomic_ref<int>(bucket_sizes[buckets[i]]).fetch_add(1);
+    }
+};
+
+
+template <typename Set>
+struct store_key_group
+{
+    Set unique_keys;
+    const typename Set::key_type* keys;
+    index_t* groups;
+
+    store_key_group(const Set& unique_keys,
+                    const typename Set::key_type* keys,
+                    index_t* groups)
+        : unique_keys(unique_keys),
+          keys(keys),
+          groups(groups)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        // The slot of the key inside the set serves as a unique identifier of all equal keys
+        groups[i] = static_cast<index_t>(unique_keys.find(keys[i]) - unique_keys.begin());
+    }
+};
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+index_t
+group_equal_keys(const Key* keys,
+                 const index_t n,
+                 index_t* groups)
+{
+    STDGPU_EXPECTS(n > 0);
+
+    // Identify equal keys by their slot in a temporary set, such that only hashing and key equality are required
+    // With one excess entry per key, neither the buckets nor the excess list can run out, so every key is inserted and found
+    using key_set = unordered_base<Key, Key, thrust::identity<Key>, Hash, KeyEqual>;
+    key_set unique_keys = key_set::createDeviceObject(next_pow2(n), n);
+    unique_keys.insert(device_cbegin(keys), device_cbegin(keys) + n);
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(n),
+                     store_key_group<key_set>(unique_keys, keys, groups));
+
+    index_t unique_count = unique_keys.size();
+
+    key_set::destroyDeviceObject(unique_keys);
+
+    return unique_count;
+}
+
+
+struct less_bucket_group
+{
+    const index_t* buckets;
+    const index_t* groups;
+
+    less_bucket_group(const index_t* buckets,
+                      const index_t* groups)
+        : buckets(buckets),
+          groups(groups)
+    {
+
+    }
+
+    STDGPU_HOST_DEVICE bool
+    operator()(const index_t a,
+               const index_t b) const
+    {
+        return (buckets[a] < buckets[b])
+            || (buckets[a] == buckets[b] && groups[a] < groups[b]);
+    }
+};
+
+
+template <typename Value>
+struct place_sorted_value
+{
+    const Value* input;
+    const index_t* order;
+    Value* values;
+
+    place_sorted_value(const Value* input,
+                       const index_t* order,
+                       Value* values)
+        : input(input),
+          order(order),
+          values(values)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        safe_device_allocator<Value> a;
+        allocator_traits<safe_device_allocator<Value>>::construct(a, &(values[i]), input[order[i]]);
+    }
+};
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::createDeviceObject(device_ptr<const value_type> begin,
+                                                                                    device_ptr<const value_type> end)
+{
+    index_t n = static_cast<index_t>(thrust::distance(begin, end));
+
+    STDGPU_EXPECTS(n >= 0);
+
+    unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual> result;
+    result._key_from_value  = key_from_value();
+    result._hash            = hasher();
+    result._key_equal       = key_equal();
+
+    if (n == 0)
+    {
+        result._bucket_count    = 1;
+        result._bucket_offsets  = createDeviceArray<index_t>(result._bucket_count + 1, 0);
+        return result;
+    }
+
+    key_type* keys = createDeviceArray<key_type>(n);
+    thrust::transform(begin, end,
+                      device_begin(keys),
+                      result._key_from_value);
+
+    index_t* groups = createDeviceArray<index_t>(n);
+    index_t unique_count = group_equal_keys<key_type, hasher, key_equal>(keys, n, groups);
+
+    result._bucket_count    = next_pow2(unique_count);
+    result._size            = n;
+    result._bucket_offsets  = createDeviceArray<index_t>(result._bucket_count + 1, 0);
+
+    // Bucket sizes are turned into bucket offsets, the additional last entry becomes the total size
+    index_t* buckets = createDeviceArray<index_t>(n);
+    int* bucket_sizes = createDeviceArray<int>(result._bucket_count + 1, 0);
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(n),
+                     count_key_bucket<key_type, hasher>(keys, buckets, bucket_sizes, result._bucket_count, result._hash));
+
+    thrust::exclusive_scan(device_cbegin(bucket_sizes), device_cend(bucket_sizes),
+                           device_begin(result._bucket_offsets),
+                           index_t(0));
+
+    destroyDeviceArray<int>(bucket_sizes);
+
+    // Sort by bucket and then by key group to store equal keys contiguously
+    index_t* order = createDeviceArray<index_t>(n);
+    thrust::sequence(device_begin(order), device_end(order));
+    thrust::sort(device_begin(order), device_end(order),
+                 less_bucket_group(buckets, groups));
+
+    allocator_type a = result.get_allocator();  // Will be replaced by member
+    result._values = allocator_traits<allocator_type>::allocate(a, n);
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(n),
+                     place_sorted_value<value_type>(begin.get(), order, result._values));
+
+    destroyDeviceArray<index_t>(order);
+    destroyDeviceArray<index_t>(buckets);
+    destroyDeviceArray<index_t>(groups);
+    destroyDeviceArray<key_type>(keys);
+
+    return result;
+}
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+struct destroy_frozen_value
+{
+    unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual> base;
+
+    destroy_frozen_value(const unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>& base)
+        : base(base)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        typename unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::allocator_type a = base.get_allocator();
+        allocator_traits<typename unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::allocator_type>::destroy(a, &(base._values[i]));
+    }
+};
+
+
+template <typename Key, typename Value, typename KeyFromValue, typename Hash, typename KeyEqual>
+void
+unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>::destroyDeviceObject(unordered_frozen_base<Key, Value, KeyFromValue, Hash, KeyEqual>& device_object)
+{
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(device_object.size()),
+                     destroy_frozen_value<Key, Value, KeyFromValue, Hash, KeyEqual>(device_object));
+
+    if (device_object._values != nullptr)
+    {
+        allocator_type a = device_object.get_allocator();   // Will be replaced by member
+        allocator_traits<allocator_type>::deallocate(a, device_object._values, device_object._size);
+    }
+
+    device_object._bucket_count = 0;
+    device_object._excess_count = 0;
+    device_object._size         = 0;
+    device_object._values       = nullptr;
+    destroyDeviceArray<index_t>(device_object._bucket_offsets);
+    device_object._key_from_value   = key_from_value();
+    device_object._hash             = hasher();
+    device_object._key_equal        = key_equal();
+}
+
+} // namespace detail
+
+} // namespace stdgpu
+
+
+
+#endif // STDGPU_UNORDERED_FROZEN_BASE_DETAIL_H
@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_UNORDERED_HASH_DETAIL_H
+#define STDGPU_UNORDERED_HASH_DETAIL_H
+
+#include <cmath>
+#include <cstdint>
+
+#include <stdgpu/bit.h>
+#include <stdgpu/config.h>
+#include <stdgpu/contract.h>
+#include <stdgpu/cstddef.h>
+#include <stdgpu/functional.h>
+#include <stdgpu/limits.h>
+#include <stdgpu/platform.h>
+
+
+
+namespace stdgpu
+{
+
+namespace detail
+{
+
+inline index_t
+next_pow2(const index_t capacity)
+{
+    STDGPU_EXPECTS(capacity > 0);
+
+    index_t result = static_cast<index_t>(1) << static_cast<index_t>(std::ceil(std::log2(capacity)));
+
+    STDGPU_ENSURES(result >= capacity);
+    STDGPU_ENSURES(ispow2<std::size_t>(result));
+
+    return result;
+}
+
+
+inline STDGPU_HOST_DEVICE index_t
+bucket_from_hash(const std::size_t hash,
+                 const index_t bucket_count)
+{
+    #if STDGPU_USE_FIBONACCI_HASHING
+        // If bucket_count == 1, then the result will be shifted by the width of std::size_t which leads to undefined/unreliable behavior
+        std::size_t result = (bucket_count == 1) ? 0 : (hash * 11400714819323198485llu) >> (numeric_limits<std::size_t>::digits - log2pow2<std::size_t>(bucket_count));
+    #else
+        std::size_t result = mod2<std::size_t>(hash, bucket_count);
+    #endif
+
+    STDGPU_ENSURES(0 <= static_cast<index_t>(result));
+    STDGPU_ENSURES(static_cast<index_t>(result) < bucket_count);
+    return static_cast<index_t>(result);
+}
+
+
+inline STDGPU_HOST_DEVICE std::uint8_t
+fingerprint_from_hash(const std::size_t hash)
+{
+    // Mix the hash such that the fingerprint is independent of the bits selecting the bucket
+    return static_cast<std::uint8_t>(mix_hash(hash));
+}
+
+} // namespace detail
+
+} // namespace stdgpu
+
+
+
+#endif // STDGPU_UNORDERED_HASH_DETAIL_H
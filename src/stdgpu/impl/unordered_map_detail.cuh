@@ -16,6 +16,12 @@
 #ifndef STDGPU_UNORDERED_MAP_DETAIL_H
 #define STDGPU_UNORDERED_MAP_DETAIL_H
 
+#include <cstring>
+#include <type_traits>
+
+#include <thrust/for_each.h>
+
+#include <stdgpu/atomic.cuh>
 #include <stdgpu/bit.h>
 #include <stdgpu/contract.h>
 #include <stdgpu/utility.h>
@@ -38,6 +44,133 @@ struct select1st
     }
 };
 
+
+template <typename T>
+struct is_atomic_combinable
+    : std::integral_constant<bool, std::is_same<T, int>::value
+                                || std::is_same<T, unsigned int>::value
+                                || std::is_same<T, unsigned long long int>::value
+                                || std::is_same<T, float>::value>
+{
+
+};
+
+
+// Compare-and-swap is only available for integral types, so other types are swapped through their bit representation
+template <typename T>
+struct atomic_combine_representation
+{
+    using type = T;
+};
+
+
+template <>
+struct atomic_combine_representation<float>
+{
+    using type = unsigned int;
+};
+
+
+template <typename To, typename From>
+inline STDGPU_HOST_DEVICE To
+representation_cast(const From& from)
+{
+    static_assert(sizeof(To) == sizeof(From), "stdgpu::detail::representation_cast : Types must have the same size");
+
+    To to;
+    std::memcpy(&to, &from, sizeof(To));
+    return to;
+}
+
+
+template <typename T, typename BinaryOperation>
+inline STDGPU_DEVICE_ONLY void
+combine_mapped(T& stored,
+               const T& obj,
+               BinaryOperation op,
+               mutex_array::reference lock,
+               std::true_type)
+{
+    // The lock is not needed since the combination is performed in a single compare-and-swap
+    (void) lock;
+
+    using representation_type = typename atomic_combine_representation<T>::type;
+
+    stdgpu::atomic_ref<representation_type> stored_ref(reinterpret_cast<representation_type&>(stored));
+
+    representation_type expected = stored_ref.load();
+    while (true)
+    {
+        T combined = op(representation_cast<T>(expected), obj);
+
+        if (stored_ref.compare_exchange_weak(expected, representation_cast<representation_type>(combined)))
+        {
+            break;
+        }
+
+        // expected has been updated to the current value, so just retry
+    }
+}
+
+
+template <typename T, typename BinaryOperation>
+inline STDGPU_DEVICE_ONLY void
+combine_mapped(T& stored,
+               const T& obj,
+               BinaryOperation op,
+               mutex_array::reference lock,
+               std::false_type)
+{
+    while (true)
+    {
+        if (lock.try_lock())
+        {
+            // START --- critical section --- START
+
+            stored = op(stored, obj);
+
+            //  END  --- critical section ---  END
+            lock.unlock();
+            break;
+        }
+    }
+}
+
+
+template <typename T>
+struct take_second
+{
+    STDGPU_HOST_DEVICE T
+    operator()(const T& first,
+               const T& second) const
+    {
+        (void) first;
+        return second;
+    }
+};
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename BinaryOperation>
+struct accumulate_value
+{
+    unordered_map<Key, T, Hash, KeyEqual> map;
+    BinaryOperation op;
+
+    accumulate_value(const unordered_map<Key, T, Hash, KeyEqual>& map,
+                     BinaryOperation op)
+        : map(map),
+          op(op)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const typename unordered_map<Key, T, Hash, KeyEqual>::value_type& value)
+    {
+        map.accumulate(value.first, value.second, op);
+    }
+};
+
 } // namespace detail
 
 template <typename Key, typename T, typename Hash, typename KeyEqual>
@@ -152,6 +285,112 @@ unordered_map<Key, T, Hash, KeyEqual>::contains(const key_type& key) const
 }
 
 
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_map<Key, T, Hash, KeyEqual>::iterator
+unordered_map<Key, T, Hash, KeyEqual>::find(const key_type& key,
+                                            const std::size_t hash)
+{
+    return _base.find(key, hash);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_map<Key, T, Hash, KeyEqual>::const_iterator
+unordered_map<Key, T, Hash, KeyEqual>::find(const key_type& key,
+                                            const std::size_t hash) const
+{
+    return _base.find(key, hash);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY bool
+unordered_map<Key, T, Hash, KeyEqual>::contains(const key_type& key,
+                                                const std::size_t hash) const
+{
+    return _base.contains(key, hash);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY typename unordered_map<Key, T, Hash, KeyEqual>::iterator
+unordered_map<Key, T, Hash, KeyEqual>::find(const KeyLike& key)
+{
+    return _base.find(key);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY typename unordered_map<Key, T, Hash, KeyEqual>::const_iterator
+unordered_map<Key, T, Hash, KeyEqual>::find(const KeyLike& key) const
+{
+    return _base.find(key);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY bool
+unordered_map<Key, T, Hash, KeyEqual>::contains(const KeyLike& key) const
+{
+    return _base.contains(key);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY typename unordered_map<Key, T, Hash, KeyEqual>::iterator
+unordered_map<Key, T, Hash, KeyEqual>::find(const KeyLike& key,
+                                            const std::size_t hash)
+{
+    return _base.find(key, hash);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY typename unordered_map<Key, T, Hash, KeyEqual>::const_iterator
+unordered_map<Key, T, Hash, KeyEqual>::find(const KeyLike& key,
+                                            const std::size_t hash) const
+{
+    return _base.find(key, hash);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY bool
+unordered_map<Key, T, Hash, KeyEqual>::contains(const KeyLike& key,
+                                                const std::size_t hash) const
+{
+    return _base.contains(key, hash);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline void
+unordered_map<Key, T, Hash, KeyEqual>::contains(device_ptr<const unordered_map<Key, T, Hash, KeyEqual>::key_type> begin,
+                                                device_ptr<const unordered_map<Key, T, Hash, KeyEqual>::key_type> end,
+                                                device_ptr<bool> result,
+                                                const unordered_lookup strategy) const
+{
+    _base.contains(begin, end, result, strategy);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline void
+unordered_map<Key, T, Hash, KeyEqual>::find(device_ptr<const unordered_map<Key, T, Hash, KeyEqual>::key_type> begin,
+                                            device_ptr<const unordered_map<Key, T, Hash, KeyEqual>::key_type> end,
+                                            device_ptr<unordered_map<Key, T, Hash, KeyEqual>::const_iterator> result,
+                                            const unordered_lookup strategy) const
+{
+    _base.find(begin, end, result, strategy);
+}
+
+
 template <typename Key, typename T, typename Hash, typename KeyEqual>
 template <class... Args>
 inline STDGPU_DEVICE_ONLY thrust::pair<typename unordered_map<Key, T, Hash, KeyEqual>::iterator, bool>
@@ -187,6 +426,90 @@ unordered_map<Key, T, Hash, KeyEqual>::insert(device_ptr<const unordered_map<Key
 }
 
 
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline device_indexed_range<const typename unordered_map<Key, T, Hash, KeyEqual>::value_type>
+unordered_map<Key, T, Hash, KeyEqual>::insert_unique(device_ptr<unordered_map<Key, T, Hash, KeyEqual>::value_type> begin,
+                                                     device_ptr<unordered_map<Key, T, Hash, KeyEqual>::value_type> end)
+{
+    return _base.insert_unique(begin, end);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline device_indexed_range<const typename unordered_map<Key, T, Hash, KeyEqual>::value_type>
+unordered_map<Key, T, Hash, KeyEqual>::insert_unique(device_ptr<const unordered_map<Key, T, Hash, KeyEqual>::value_type> begin,
+                                                     device_ptr<const unordered_map<Key, T, Hash, KeyEqual>::value_type> end)
+{
+    return _base.insert_unique(begin, end);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline void
+unordered_map<Key, T, Hash, KeyEqual>::insert_from_host(host_ptr<const unordered_map<Key, T, Hash, KeyEqual>::value_type> begin,
+                                                        host_ptr<const unordered_map<Key, T, Hash, KeyEqual>::value_type> end,
+                                                        const index_t chunk_size)
+{
+    _base.insert_from_host(begin, end, chunk_size);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename BinaryOperation>
+inline STDGPU_DEVICE_ONLY thrust::pair<typename unordered_map<Key, T, Hash, KeyEqual>::iterator, bool>
+unordered_map<Key, T, Hash, KeyEqual>::accumulate(const key_type& key,
+                                                  const mapped_type& obj,
+                                                  BinaryOperation op)
+{
+    while (true)
+    {
+        // Combine with an existing value, which is fully constructed once it is found
+        iterator it = _base.find(key);
+        if (it != _base.end())
+        {
+            detail::combine_mapped(it->second, obj, op,
+                                   _base._locks[static_cast<index_t>(it - _base.begin())],
+                                   detail::is_atomic_combinable<mapped_type>());
+
+            return thrust::make_pair(it, false);
+        }
+
+        if (_base.full() || _base._excess_list_positions.empty())
+        {
+            return thrust::make_pair(_base.end(), false);
+        }
+
+        // Might fail due to contention or a concurrent insertion of the same key, so retry
+        thrust::pair<iterator, bool> inserted = _base.try_insert(value_type(key, obj));
+        if (inserted.second)
+        {
+            return inserted;
+        }
+    }
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename BinaryOperation>
+inline void
+unordered_map<Key, T, Hash, KeyEqual>::accumulate(device_ptr<const unordered_map<Key, T, Hash, KeyEqual>::value_type> begin,
+                                                  device_ptr<const unordered_map<Key, T, Hash, KeyEqual>::value_type> end,
+                                                  BinaryOperation op)
+{
+    thrust::for_each(begin, end,
+                     detail::accumulate_value<Key, T, Hash, KeyEqual, BinaryOperation>(*this, op));
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY thrust::pair<typename unordered_map<Key, T, Hash, KeyEqual>::iterator, bool>
+unordered_map<Key, T, Hash, KeyEqual>::insert_or_assign(const key_type& key,
+                                                        const mapped_type& obj)
+{
+    return accumulate(key, obj, detail::take_second<mapped_type>());
+}
+
+
 template <typename Key, typename T, typename Hash, typename KeyEqual>
 inline STDGPU_DEVICE_ONLY typename unordered_map<Key, T, Hash, KeyEqual>::index_type
 unordered_map<Key, T, Hash, KeyEqual>::erase(const unordered_map<Key, T, Hash, KeyEqual>::key_type& key)
@@ -213,6 +536,23 @@ unordered_map<Key, T, Hash, KeyEqual>::erase(device_ptr<const unordered_map<Key,
 }
 
 
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename UnaryPredicate>
+inline typename unordered_map<Key, T, Hash, KeyEqual>::index_type
+unordered_map<Key, T, Hash, KeyEqual>::erase_if(UnaryPredicate pred)
+{
+    return _base.erase_if(pred);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline void
+unordered_map<Key, T, Hash, KeyEqual>::merge(unordered_map<Key, T, Hash, KeyEqual>& source)
+{
+    _base.merge(source._base);
+}
+
+
 template <typename Key, typename T, typename Hash, typename KeyEqual>
 inline STDGPU_HOST_DEVICE bool
 unordered_map<Key, T, Hash, KeyEqual>::empty() const
@@ -285,6 +625,14 @@ unordered_map<Key, T, Hash, KeyEqual>::max_load_factor() const
 }
 
 
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+unordered_statistics
+unordered_map<Key, T, Hash, KeyEqual>::statistics() const
+{
+    return _base.statistics();
+}
+
+
 template <typename Key, typename T, typename Hash, typename KeyEqual>
 inline STDGPU_HOST_DEVICE typename unordered_map<Key, T, Hash, KeyEqual>::hasher
 unordered_map<Key, T, Hash, KeyEqual>::hash_function() const
@@ -317,6 +665,14 @@ unordered_map<Key, T, Hash, KeyEqual>::clear()
 }
 
 
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+unordered_compaction
+unordered_map<Key, T, Hash, KeyEqual>::compact()
+{
+    return _base.compact();
+}
+
+
 
 template <typename Key, typename T, typename Hash, typename KeyEqual>
 unordered_map<Key, T, Hash, KeyEqual>
@@ -354,6 +710,55 @@ unordered_map<Key, T, Hash, KeyEqual>::destroyDeviceObject(unordered_map<Key, T,
     detail::unordered_base<key_type, value_type, detail::select1st<value_type>, hasher, key_equal>::destroyDeviceObject(device_object._base);
 }
 
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+typename unordered_map<Key, T, Hash, KeyEqual>::frozen_type
+unordered_map<Key, T, Hash, KeyEqual>::freeze(unordered_map<Key, T, Hash, KeyEqual>& device_object)
+{
+    return detail::unordered_base<key_type, value_type, detail::select1st<value_type>, hasher, key_equal>::freeze(device_object._base);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+unordered_map<Key, T, Hash, KeyEqual>
+unordered_map<Key, T, Hash, KeyEqual>::thaw(frozen_type& frozen_object)
+{
+    unordered_map<Key, T, Hash, KeyEqual> result;
+    result._base = detail::unordered_base<key_type, value_type, detail::select1st<value_type>, hasher, key_equal>::thaw(frozen_object);
+
+    return result;
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline void
+set_union(const unordered_map<Key, T, Hash, KeyEqual>& a,
+          const unordered_map<Key, T, Hash, KeyEqual>& b,
+          unordered_map<Key, T, Hash, KeyEqual>& result)
+{
+    detail::unordered_set_union<detail::select1st<thrust::pair<const Key, T>>>(a, b, result);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline void
+set_intersection(const unordered_map<Key, T, Hash, KeyEqual>& a,
+                 const unordered_map<Key, T, Hash, KeyEqual>& b,
+                 unordered_map<Key, T, Hash, KeyEqual>& result)
+{
+    detail::unordered_set_intersection<detail::select1st<thrust::pair<const Key, T>>>(a, b, result);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline void
+set_difference(const unordered_map<Key, T, Hash, KeyEqual>& a,
+               const unordered_map<Key, T, Hash, KeyEqual>& b,
+               unordered_map<Key, T, Hash, KeyEqual>& result)
+{
+    detail::unordered_set_difference<detail::select1st<thrust::pair<const Key, T>>>(a, b, result);
+}
+
 } // namespace stdgpu
 
 
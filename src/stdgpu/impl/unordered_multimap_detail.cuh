@@ -0,0 +1,282 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_UNORDERED_MULTIMAP_DETAIL_H
+#define STDGPU_UNORDERED_MULTIMAP_DETAIL_H
+
+#include <thrust/distance.h>
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include <stdgpu/contract.h>
+#include <stdgpu/iterator.h>
+#include <stdgpu/memory.h>
+
+
+
+namespace stdgpu
+{
+
+namespace detail
+{
+
+template <typename Key, typename T>
+struct make_multimap_value
+{
+    const Key* keys;
+    const T* mapped;
+    thrust::pair<const Key, T>* values;
+
+    make_multimap_value(const Key* keys,
+                        const T* mapped,
+                        thrust::pair<const Key, T>* values)
+        : keys(keys),
+          mapped(mapped),
+          values(values)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        safe_device_allocator<thrust::pair<const Key, T>> a;
+        allocator_traits<safe_device_allocator<thrust::pair<const Key, T>>>::construct(a, &(values[i]), keys[i], mapped[i]);
+    }
+};
+
+
+template <typename Value>
+struct destroy_multimap_value
+{
+    Value* values;
+
+    destroy_multimap_value(Value* values)
+        : values(values)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        safe_device_allocator<Value> a;
+        allocator_traits<safe_device_allocator<Value>>::destroy(a, &(values[i]));
+    }
+};
+
+} // namespace detail
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename unordered_multimap<Key, T, Hash, KeyEqual>::allocator_type
+unordered_multimap<Key, T, Hash, KeyEqual>::get_allocator() const
+{
+    return _base.get_allocator();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+bool
+unordered_multimap<Key, T, Hash, KeyEqual>::valid() const
+{
+    return _base.valid();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_multimap<Key, T, Hash, KeyEqual>::const_iterator
+unordered_multimap<Key, T, Hash, KeyEqual>::begin() const
+{
+    return _base.begin();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_multimap<Key, T, Hash, KeyEqual>::const_iterator
+unordered_multimap<Key, T, Hash, KeyEqual>::cbegin() const
+{
+    return _base.cbegin();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_multimap<Key, T, Hash, KeyEqual>::const_iterator
+unordered_multimap<Key, T, Hash, KeyEqual>::end() const
+{
+    return _base.end();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_multimap<Key, T, Hash, KeyEqual>::const_iterator
+unordered_multimap<Key, T, Hash, KeyEqual>::cend() const
+{
+    return _base.cend();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+stdgpu::device_range<const typename unordered_multimap<Key, T, Hash, KeyEqual>::value_type>
+unordered_multimap<Key, T, Hash, KeyEqual>::device_range() const
+{
+    return _base.device_range();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+unordered_multimap<Key, T, Hash, KeyEqual>::bucket(const key_type& key) const
+{
+    return _base.bucket(key);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY index_t
+unordered_multimap<Key, T, Hash, KeyEqual>::bucket_size(index_type n) const
+{
+    return _base.bucket_size(n);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY index_t
+unordered_multimap<Key, T, Hash, KeyEqual>::count(const key_type& key) const
+{
+    return _base.count(key);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_multimap<Key, T, Hash, KeyEqual>::const_iterator
+unordered_multimap<Key, T, Hash, KeyEqual>::find(const key_type& key) const
+{
+    return _base.find(key);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY bool
+unordered_multimap<Key, T, Hash, KeyEqual>::contains(const key_type& key) const
+{
+    return _base.contains(key);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY thrust::pair<typename unordered_multimap<Key, T, Hash, KeyEqual>::const_iterator, typename unordered_multimap<Key, T, Hash, KeyEqual>::const_iterator>
+unordered_multimap<Key, T, Hash, KeyEqual>::equal_range(const key_type& key) const
+{
+    return _base.equal_range(key);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE bool
+unordered_multimap<Key, T, Hash, KeyEqual>::empty() const
+{
+    return _base.empty();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+unordered_multimap<Key, T, Hash, KeyEqual>::size() const
+{
+    return _base.size();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+unordered_multimap<Key, T, Hash, KeyEqual>::bucket_count() const
+{
+    return _base.bucket_count();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename unordered_multimap<Key, T, Hash, KeyEqual>::hasher
+unordered_multimap<Key, T, Hash, KeyEqual>::hash_function() const
+{
+    return _base.hash_function();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename unordered_multimap<Key, T, Hash, KeyEqual>::key_equal
+unordered_multimap<Key, T, Hash, KeyEqual>::key_eq() const
+{
+    return _base.key_eq();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+unordered_multimap<Key, T, Hash, KeyEqual>
+unordered_multimap<Key, T, Hash, KeyEqual>::createDeviceObject(device_ptr<const value_type> begin,
+                                                                device_ptr<const value_type> end)
+{
+    unordered_multimap<Key, T, Hash, KeyEqual> result;
+    result._base = detail::unordered_frozen_base<key_type, value_type, detail::select1st<value_type>, hasher, key_equal>::createDeviceObject(begin, end);
+
+    return result;
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+unordered_multimap<Key, T, Hash, KeyEqual>
+unordered_multimap<Key, T, Hash, KeyEqual>::createDeviceObject(device_ptr<const key_type> key_begin,
+                                                                device_ptr<const key_type> key_end,
+                                                                device_ptr<const mapped_type> mapped_begin)
+{
+    index_t n = static_cast<index_t>(thrust::distance(key_begin, key_end));
+
+    if (n == 0)
+    {
+        return createDeviceObject(make_device(static_cast<const value_type*>(nullptr)), make_device(static_cast<const value_type*>(nullptr)));
+    }
+
+    // Zip keys and mapped values into a temporary value array
+    allocator_type a;   // Will be replaced by member
+    value_type* values = allocator_traits<allocator_type>::allocate(a, n);
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(n),
+                     detail::make_multimap_value<key_type, mapped_type>(key_begin.get(), mapped_begin.get(), values));
+
+    unordered_multimap<Key, T, Hash, KeyEqual> result = createDeviceObject(make_device(static_cast<const value_type*>(values)),
+                                                                           make_device(static_cast<const value_type*>(values)) + n);
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(n),
+                     detail::destroy_multimap_value<value_type>(values));
+
+    allocator_traits<allocator_type>::deallocate(a, values, n);
+
+    return result;
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+void
+unordered_multimap<Key, T, Hash, KeyEqual>::destroyDeviceObject(unordered_multimap<Key, T, Hash, KeyEqual>& device_object)
+{
+    detail::unordered_frozen_base<key_type, value_type, detail::select1st<value_type>, hasher, key_equal>::destroyDeviceObject(device_object._base);
+}
+
+} // namespace stdgpu
+
+
+
+#endif // STDGPU_UNORDERED_MULTIMAP_DETAIL_H
@@ -0,0 +1,195 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_UNORDERED_MULTISET_DETAIL_H
+#define STDGPU_UNORDERED_MULTISET_DETAIL_H
+
+#include <stdgpu/contract.h>
+#include <stdgpu/iterator.h>
+#include <stdgpu/memory.h>
+
+
+
+namespace stdgpu
+{
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename unordered_multiset<Key, Hash, KeyEqual>::allocator_type
+unordered_multiset<Key, Hash, KeyEqual>::get_allocator() const
+{
+    return _base.get_allocator();
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+bool
+unordered_multiset<Key, Hash, KeyEqual>::valid() const
+{
+    return _base.valid();
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_multiset<Key, Hash, KeyEqual>::const_iterator
+unordered_multiset<Key, Hash, KeyEqual>::begin() const
+{
+    return _base.begin();
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_multiset<Key, Hash, KeyEqual>::const_iterator
+unordered_multiset<Key, Hash, KeyEqual>::cbegin() const
+{
+    return _base.cbegin();
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_multiset<Key, Hash, KeyEqual>::const_iterator
+unordered_multiset<Key, Hash, KeyEqual>::end() const
+{
+    return _base.end();
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_multiset<Key, Hash, KeyEqual>::const_iterator
+unordered_multiset<Key, Hash, KeyEqual>::cend() const
+{
+    return _base.cend();
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+stdgpu::device_range<const typename unordered_multiset<Key, Hash, KeyEqual>::value_type>
+unordered_multiset<Key, Hash, KeyEqual>::device_range() const
+{
+    return _base.device_range();
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+unordered_multiset<Key, Hash, KeyEqual>::bucket(const key_type& key) const
+{
+    return _base.bucket(key);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY index_t
+unordered_multiset<Key, Hash, KeyEqual>::bucket_size(index_type n) const
+{
+    return _base.bucket_size(n);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY index_t
+unordered_multiset<Key, Hash, KeyEqual>::count(const key_type& key) const
+{
+    return _base.count(key);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_multiset<Key, Hash, KeyEqual>::const_iterator
+unordered_multiset<Key, Hash, KeyEqual>::find(const key_type& key) const
+{
+    return _base.find(key);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY bool
+unordered_multiset<Key, Hash, KeyEqual>::contains(const key_type& key) const
+{
+    return _base.contains(key);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY thrust::pair<typename unordered_multiset<Key, Hash, KeyEqual>::const_iterator, typename unordered_multiset<Key, Hash, KeyEqual>::const_iterator>
+unordered_multiset<Key, Hash, KeyEqual>::equal_range(const key_type& key) const
+{
+    return _base.equal_range(key);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE bool
+unordered_multiset<Key, Hash, KeyEqual>::empty() const
+{
+    return _base.empty();
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+unordered_multiset<Key, Hash, KeyEqual>::size() const
+{
+    return _base.size();
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+unordered_multiset<Key, Hash, KeyEqual>::bucket_count() const
+{
+    return _base.bucket_count();
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename unordered_multiset<Key, Hash, KeyEqual>::hasher
+unordered_multiset<Key, Hash, KeyEqual>::hash_function() const
+{
+    return _base.hash_function();
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename unordered_multiset<Key, Hash, KeyEqual>::key_equal
+unordered_multiset<Key, Hash, KeyEqual>::key_eq() const
+{
+    return _base.key_eq();
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+unordered_multiset<Key, Hash, KeyEqual>
+unordered_multiset<Key, Hash, KeyEqual>::createDeviceObject(device_ptr<const value_type> begin,
+                                                             device_ptr<const value_type> end)
+{
+    unordered_multiset<Key, Hash, KeyEqual> result;
+    result._base = detail::unordered_frozen_base<key_type, value_type, thrust::identity<key_type>, hasher, key_equal>::createDeviceObject(begin, end);
+
+    return result;
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+void
+unordered_multiset<Key, Hash, KeyEqual>::destroyDeviceObject(unordered_multiset<Key, Hash, KeyEqual>& device_object)
+{
+    detail::unordered_frozen_base<key_type, value_type, thrust::identity<key_type>, hasher, key_equal>::destroyDeviceObject(device_object._base);
+}
+
+} // namespace stdgpu
+
+
+
+#endif // STDGPU_UNORDERED_MULTISET_DETAIL_H
@@ -137,6 +137,112 @@ unordered_set<Key, Hash, KeyEqual>::contains(const key_type& key) const
 }
 
 
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_set<Key, Hash, KeyEqual>::iterator
+unordered_set<Key, Hash, KeyEqual>::find(const key_type& key,
+                                         const std::size_t hash)
+{
+    return _base.find(key, hash);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_set<Key, Hash, KeyEqual>::const_iterator
+unordered_set<Key, Hash, KeyEqual>::find(const key_type& key,
+                                         const std::size_t hash) const
+{
+    return _base.find(key, hash);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY bool
+unordered_set<Key, Hash, KeyEqual>::contains(const key_type& key,
+                                             const std::size_t hash) const
+{
+    return _base.contains(key, hash);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY typename unordered_set<Key, Hash, KeyEqual>::iterator
+unordered_set<Key, Hash, KeyEqual>::find(const KeyLike& key)
+{
+    return _base.find(key);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY typename unordered_set<Key, Hash, KeyEqual>::const_iterator
+unordered_set<Key, Hash, KeyEqual>::find(const KeyLike& key) const
+{
+    return _base.find(key);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY bool
+unordered_set<Key, Hash, KeyEqual>::contains(const KeyLike& key) const
+{
+    return _base.contains(key);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY typename unordered_set<Key, Hash, KeyEqual>::iterator
+unordered_set<Key, Hash, KeyEqual>::find(const KeyLike& key,
+                                         const std::size_t hash)
+{
+    return _base.find(key, hash);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY typename unordered_set<Key, Hash, KeyEqual>::const_iterator
+unordered_set<Key, Hash, KeyEqual>::find(const KeyLike& key,
+                                         const std::size_t hash) const
+{
+    return _base.find(key, hash);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+template <typename KeyLike, typename>
+inline STDGPU_DEVICE_ONLY bool
+unordered_set<Key, Hash, KeyEqual>::contains(const KeyLike& key,
+                                             const std::size_t hash) const
+{
+    return _base.contains(key, hash);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline void
+unordered_set<Key, Hash, KeyEqual>::contains(device_ptr<const unordered_set<Key, Hash, KeyEqual>::key_type> begin,
+                                             device_ptr<const unordered_set<Key, Hash, KeyEqual>::key_type> end,
+                                             device_ptr<bool> result,
+                                             const unordered_lookup strategy) const
+{
+    _base.contains(begin, end, result, strategy);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline void
+unordered_set<Key, Hash, KeyEqual>::find(device_ptr<const unordered_set<Key, Hash, KeyEqual>::key_type> begin,
+                                         device_ptr<const unordered_set<Key, Hash, KeyEqual>::key_type> end,
+                                         device_ptr<unordered_set<Key, Hash, KeyEqual>::const_iterator> result,
+                                         const unordered_lookup strategy) const
+{
+    _base.find(begin, end, result, strategy);
+}
+
+
 template <typename Key, typename Hash, typename KeyEqual>
 template <class... Args>
 inline STDGPU_DEVICE_ONLY thrust::pair<typename unordered_set<Key, Hash, KeyEqual>::iterator, bool>
@@ -172,6 +278,34 @@ unordered_set<Key, Hash, KeyEqual>::insert(device_ptr<const unordered_set<Key, H
 }
 
 
+template <typename Key, typename Hash, typename KeyEqual>
+inline device_indexed_range<const typename unordered_set<Key, Hash, KeyEqual>::value_type>
+unordered_set<Key, Hash, KeyEqual>::insert_unique(device_ptr<unordered_set<Key, Hash, KeyEqual>::value_type> begin,
+                                                  device_ptr<unordered_set<Key, Hash, KeyEqual>::value_type> end)
+{
+    return _base.insert_unique(begin, end);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline device_indexed_range<const typename unordered_set<Key, Hash, KeyEqual>::value_type>
+unordered_set<Key, Hash, KeyEqual>::insert_unique(device_ptr<const unordered_set<Key, Hash, KeyEqual>::value_type> begin,
+                                                  device_ptr<const unordered_set<Key, Hash, KeyEqual>::value_type> end)
+{
+    return _base.insert_unique(begin, end);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline void
+unordered_set<Key, Hash, KeyEqual>::insert_from_host(host_ptr<const unordered_set<Key, Hash, KeyEqual>::value_type> begin,
+                                                     host_ptr<const unordered_set<Key, Hash, KeyEqual>::value_type> end,
+                                                     const index_t chunk_size)
+{
+    _base.insert_from_host(begin, end, chunk_size);
+}
+
+
 template <typename Key, typename Hash, typename KeyEqual>
 inline STDGPU_DEVICE_ONLY typename unordered_set<Key, Hash, KeyEqual>::index_type
 unordered_set<Key, Hash, KeyEqual>::erase(const unordered_set<Key, Hash, KeyEqual>::key_type& key)
@@ -198,6 +332,23 @@ unordered_set<Key, Hash, KeyEqual>::erase(device_ptr<const unordered_set<Key, Ha
 }
 
 
+template <typename Key, typename Hash, typename KeyEqual>
+template <typename UnaryPredicate>
+inline typename unordered_set<Key, Hash, KeyEqual>::index_type
+unordered_set<Key, Hash, KeyEqual>::erase_if(UnaryPredicate pred)
+{
+    return _base.erase_if(pred);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline void
+unordered_set<Key, Hash, KeyEqual>::merge(unordered_set<Key, Hash, KeyEqual>& source)
+{
+    _base.merge(source._base);
+}
+
+
 template <typename Key, typename Hash, typename KeyEqual>
 inline STDGPU_HOST_DEVICE bool
 unordered_set<Key, Hash, KeyEqual>::empty() const
@@ -270,6 +421,14 @@ unordered_set<Key, Hash, KeyEqual>::max_load_factor() const
 }
 
 
+template <typename Key, typename Hash, typename KeyEqual>
+unordered_statistics
+unordered_set<Key, Hash, KeyEqual>::statistics() const
+{
+    return _base.statistics();
+}
+
+
 template <typename Key, typename Hash, typename KeyEqual>
 inline STDGPU_HOST_DEVICE typename unordered_set<Key, Hash, KeyEqual>::hasher
 unordered_set<Key, Hash, KeyEqual>::hash_function() const
@@ -302,6 +461,14 @@ unordered_set<Key, Hash, KeyEqual>::clear()
 }
 
 
+template <typename Key, typename Hash, typename KeyEqual>
+unordered_compaction
+unordered_set<Key, Hash, KeyEqual>::compact()
+{
+    return _base.compact();
+}
+
+
 
 template <typename Key, typename Hash, typename KeyEqual>
 unordered_set<Key, Hash, KeyEqual>
@@ -339,6 +506,85 @@ unordered_set<Key, Hash, KeyEqual>::destroyDeviceObject(unordered_set<Key, Hash,
     detail::unordered_base<key_type, value_type, thrust::identity<key_type>, hasher, key_equal>::destroyDeviceObject(device_object._base);
 }
 
+
+template <typename Key, typename Hash, typename KeyEqual>
+typename unordered_set<Key, Hash, KeyEqual>::frozen_type
+unordered_set<Key, Hash, KeyEqual>::freeze(unordered_set<Key, Hash, KeyEqual>& device_object)
+{
+    return detail::unordered_base<key_type, value_type, thrust::identity<key_type>, hasher, key_equal>::freeze(device_object._base);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+unordered_set<Key, Hash, KeyEqual>
+unordered_set<Key, Hash, KeyEqual>::thaw(frozen_type& frozen_object)
+{
+    unordered_set<Key, Hash, KeyEqual> result;
+    result._base = detail::unordered_base<key_type, value_type, thrust::identity<key_type>, hasher, key_equal>::thaw(frozen_object);
+
+    return result;
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline void
+set_union(const unordered_set<Key, Hash, KeyEqual>& a,
+          const unordered_set<Key, Hash, KeyEqual>& b,
+          unordered_set<Key, Hash, KeyEqual>& result)
+{
+    detail::unordered_set_union<thrust::identity<Key>>(a, b, result);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline void
+set_union(const unordered_set<Key, Hash, KeyEqual>& a,
+          const unordered_set<Key, Hash, KeyEqual>& b,
+          vector<Key>& result)
+{
+    detail::unordered_set_union<thrust::identity<Key>>(a, b, result);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline void
+set_intersection(const unordered_set<Key, Hash, KeyEqual>& a,
+                 const unordered_set<Key, Hash, KeyEqual>& b,
+                 unordered_set<Key, Hash, KeyEqual>& result)
+{
+    detail::unordered_set_intersection<thrust::identity<Key>>(a, b, result);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline void
+set_intersection(const unordered_set<Key, Hash, KeyEqual>& a,
+                 const unordered_set<Key, Hash, KeyEqual>& b,
+                 vector<Key>& result)
+{
+    detail::unordered_set_intersection<thrust::identity<Key>>(a, b, result);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline void
+set_difference(const unordered_set<Key, Hash, KeyEqual>& a,
+               const unordered_set<Key, Hash, KeyEqual>& b,
+               unordered_set<Key, Hash, KeyEqual>& result)
+{
+    detail::unordered_set_difference<thrust::identity<Key>>(a, b, result);
+}
+
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline void
+set_difference(const unordered_set<Key, Hash, KeyEqual>& a,
+               const unordered_set<Key, Hash, KeyEqual>& b,
+               vector<Key>& result)
+{
+    detail::unordered_set_difference<thrust::identity<Key>>(a, b, result);
+}
+
 } // namespace stdgpu
 
 
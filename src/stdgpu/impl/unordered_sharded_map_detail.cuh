@@ -0,0 +1,396 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_UNORDERED_SHARDED_MAP_DETAIL_H
+#define STDGPU_UNORDERED_SHARDED_MAP_DETAIL_H
+
+#include <thrust/for_each.h>
+#include <thrust/logical.h>
+
+#include <stdgpu/contract.h>
+#include <stdgpu/functional.h>
+#include <stdgpu/iterator.h>
+#include <stdgpu/memory.h>
+#include <stdgpu/utility.h>
+
+
+
+namespace stdgpu
+{
+
+namespace detail
+{
+
+inline STDGPU_HOST_DEVICE index_t
+shard_from_hash(const std::size_t hash,
+                const index_t shard_count)
+{
+    // Use the upper half of the mixed hash such that the shard is independent of both the bucket and the fingerprint
+    unsigned long long result = (mix_hash(hash) >> 32) % static_cast<unsigned long long>(shard_count);
+
+    STDGPU_ENSURES(0 <= static_cast<index_t>(result));
+    STDGPU_ENSURES(static_cast<index_t>(result) < shard_count);
+    return static_cast<index_t>(result);
+}
+
+
+template <typename ShardedMap>
+struct sharded_insert_value
+{
+    ShardedMap map;
+
+    sharded_insert_value(const ShardedMap& map)
+        : map(map)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const typename ShardedMap::value_type& value)
+    {
+        map.insert(value);
+    }
+};
+
+
+template <typename ShardedMap>
+struct sharded_erase_key
+{
+    ShardedMap map;
+
+    sharded_erase_key(const ShardedMap& map)
+        : map(map)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const typename ShardedMap::key_type& key)
+    {
+        map.erase(key);
+    }
+};
+
+
+template <typename ShardedMap>
+struct value_in_shard
+{
+    ShardedMap map;
+    index_t n;
+
+    value_in_shard(const ShardedMap& map,
+                   const index_t n)
+        : map(map),
+          n(n)
+    {
+
+    }
+
+    STDGPU_HOST_DEVICE bool
+    operator()(const typename ShardedMap::value_type& value) const
+    {
+        return map.shard(value.first) == n;
+    }
+};
+
+} // namespace detail
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_sharded_map<Key, T, Hash, KeyEqual>::iterator
+unordered_sharded_map<Key, T, Hash, KeyEqual>::end()
+{
+    return iterator();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_sharded_map<Key, T, Hash, KeyEqual>::const_iterator
+unordered_sharded_map<Key, T, Hash, KeyEqual>::end() const
+{
+    return const_iterator();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_sharded_map<Key, T, Hash, KeyEqual>::const_iterator
+unordered_sharded_map<Key, T, Hash, KeyEqual>::cend() const
+{
+    return end();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+unordered_sharded_map<Key, T, Hash, KeyEqual>::shard_count() const
+{
+    return _shard_count;
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename unordered_sharded_map<Key, T, Hash, KeyEqual>::index_type
+unordered_sharded_map<Key, T, Hash, KeyEqual>::shard(const unordered_sharded_map<Key, T, Hash, KeyEqual>::key_type& key) const
+{
+    return detail::shard_from_hash(_hash(key), shard_count());
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_sharded_map<Key, T, Hash, KeyEqual>::index_type
+unordered_sharded_map<Key, T, Hash, KeyEqual>::count(const unordered_sharded_map<Key, T, Hash, KeyEqual>::key_type& key) const
+{
+    return contains(key) ? index_type(1) : index_type(0);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_sharded_map<Key, T, Hash, KeyEqual>::iterator
+unordered_sharded_map<Key, T, Hash, KeyEqual>::find(const unordered_sharded_map<Key, T, Hash, KeyEqual>::key_type& key)
+{
+    std::size_t hash = _hash(key);
+    shard_type& owner = _shards[detail::shard_from_hash(hash, shard_count())];
+
+    iterator it = owner.find(key, hash);
+    return (it != owner.end()) ? it : end();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_sharded_map<Key, T, Hash, KeyEqual>::const_iterator
+unordered_sharded_map<Key, T, Hash, KeyEqual>::find(const unordered_sharded_map<Key, T, Hash, KeyEqual>::key_type& key) const
+{
+    std::size_t hash = _hash(key);
+    const shard_type& owner = _shards[detail::shard_from_hash(hash, shard_count())];
+
+    const_iterator it = owner.find(key, hash);
+    return (it != owner.end()) ? it : end();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY bool
+unordered_sharded_map<Key, T, Hash, KeyEqual>::contains(const unordered_sharded_map<Key, T, Hash, KeyEqual>::key_type& key) const
+{
+    std::size_t hash = _hash(key);
+    const shard_type& owner = _shards[detail::shard_from_hash(hash, shard_count())];
+
+    return owner.contains(key, hash);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <class... Args>
+inline STDGPU_DEVICE_ONLY thrust::pair<typename unordered_sharded_map<Key, T, Hash, KeyEqual>::iterator, bool>
+unordered_sharded_map<Key, T, Hash, KeyEqual>::emplace(Args&&... args)
+{
+    return insert(value_type(forward<Args>(args)...));
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY thrust::pair<typename unordered_sharded_map<Key, T, Hash, KeyEqual>::iterator, bool>
+unordered_sharded_map<Key, T, Hash, KeyEqual>::insert(const unordered_sharded_map<Key, T, Hash, KeyEqual>::value_type& value)
+{
+    thrust::pair<iterator, bool> result = _shards[shard(value.first)].insert(value);
+
+    if (!result.second)
+    {
+        result.first = end();
+    }
+
+    return result;
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline void
+unordered_sharded_map<Key, T, Hash, KeyEqual>::insert(device_ptr<unordered_sharded_map<Key, T, Hash, KeyEqual>::value_type> begin,
+                                                      device_ptr<unordered_sharded_map<Key, T, Hash, KeyEqual>::value_type> end)
+{
+    thrust::for_each(begin, end,
+                     detail::sharded_insert_value<unordered_sharded_map<Key, T, Hash, KeyEqual>>(*this));
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline void
+unordered_sharded_map<Key, T, Hash, KeyEqual>::insert(device_ptr<const unordered_sharded_map<Key, T, Hash, KeyEqual>::value_type> begin,
+                                                      device_ptr<const unordered_sharded_map<Key, T, Hash, KeyEqual>::value_type> end)
+{
+    thrust::for_each(begin, end,
+                     detail::sharded_insert_value<unordered_sharded_map<Key, T, Hash, KeyEqual>>(*this));
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_sharded_map<Key, T, Hash, KeyEqual>::index_type
+unordered_sharded_map<Key, T, Hash, KeyEqual>::erase(const unordered_sharded_map<Key, T, Hash, KeyEqual>::key_type& key)
+{
+    return _shards[shard(key)].erase(key);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline void
+unordered_sharded_map<Key, T, Hash, KeyEqual>::erase(device_ptr<unordered_sharded_map<Key, T, Hash, KeyEqual>::key_type> begin,
+                                                     device_ptr<unordered_sharded_map<Key, T, Hash, KeyEqual>::key_type> end)
+{
+    thrust::for_each(begin, end,
+                     detail::sharded_erase_key<unordered_sharded_map<Key, T, Hash, KeyEqual>>(*this));
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline void
+unordered_sharded_map<Key, T, Hash, KeyEqual>::erase(device_ptr<const unordered_sharded_map<Key, T, Hash, KeyEqual>::key_type> begin,
+                                                     device_ptr<const unordered_sharded_map<Key, T, Hash, KeyEqual>::key_type> end)
+{
+    thrust::for_each(begin, end,
+                     detail::sharded_erase_key<unordered_sharded_map<Key, T, Hash, KeyEqual>>(*this));
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline bool
+unordered_sharded_map<Key, T, Hash, KeyEqual>::empty() const
+{
+    return (size() == 0);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline index_t
+unordered_sharded_map<Key, T, Hash, KeyEqual>::size() const
+{
+    index_t result = 0;
+    for (index_t i = 0; i < shard_count(); ++i)
+    {
+        result += _host_shards[i].size();
+    }
+
+    return result;
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline index_t
+unordered_sharded_map<Key, T, Hash, KeyEqual>::max_size() const
+{
+    index_t result = 0;
+    for (index_t i = 0; i < shard_count(); ++i)
+    {
+        result += _host_shards[i].max_size();
+    }
+
+    return result;
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename unordered_sharded_map<Key, T, Hash, KeyEqual>::hasher
+unordered_sharded_map<Key, T, Hash, KeyEqual>::hash_function() const
+{
+    return _hash;
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename unordered_sharded_map<Key, T, Hash, KeyEqual>::key_equal
+unordered_sharded_map<Key, T, Hash, KeyEqual>::key_eq() const
+{
+    return key_equal();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+bool
+unordered_sharded_map<Key, T, Hash, KeyEqual>::valid() const
+{
+    for (index_t i = 0; i < shard_count(); ++i)
+    {
+        if (!_host_shards[i].valid())
+        {
+            return false;
+        }
+
+        auto range = _host_shards[i].device_range();
+        if (!thrust::all_of(range.begin(), range.end(),
+                            detail::value_in_shard<unordered_sharded_map<Key, T, Hash, KeyEqual>>(*this, i)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+void
+unordered_sharded_map<Key, T, Hash, KeyEqual>::clear()
+{
+    for (index_t i = 0; i < shard_count(); ++i)
+    {
+        _host_shards[i].clear();
+    }
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+unordered_sharded_map<Key, T, Hash, KeyEqual>
+unordered_sharded_map<Key, T, Hash, KeyEqual>::createDeviceObject(const index_t& capacity,
+                                                                  const index_t& shard_count)
+{
+    STDGPU_EXPECTS(capacity > 0);
+    STDGPU_EXPECTS(shard_count > 0);
+
+    const index_t shard_capacity = (capacity + shard_count - 1) / shard_count;
+
+    unordered_sharded_map<Key, T, Hash, KeyEqual> result;
+    result._shard_count = shard_count;
+    result._hash        = hasher();
+
+    // Each shard is allocated and initialized on its own, so its memory is not interleaved with the other shards
+    result._host_shards = createHostArray<shard_type>(shard_count);
+    for (index_t i = 0; i < shard_count; ++i)
+    {
+        result._host_shards[i] = shard_type::createDeviceObject(shard_capacity);
+    }
+    result._shards      = copyCreateHost2DeviceArray<shard_type>(result._host_shards, shard_count);
+
+    return result;
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+void
+unordered_sharded_map<Key, T, Hash, KeyEqual>::destroyDeviceObject(unordered_sharded_map<Key, T, Hash, KeyEqual>& device_object)
+{
+    for (index_t i = 0; i < device_object._shard_count; ++i)
+    {
+        shard_type::destroyDeviceObject(device_object._host_shards[i]);
+    }
+
+    destroyDeviceArray<shard_type>(device_object._shards);
+    destroyHostArray<shard_type>(device_object._host_shards);
+    device_object._shard_count = 0;
+}
+
+} // namespace stdgpu
+
+
+
+#endif // STDGPU_UNORDERED_SHARDED_MAP_DETAIL_H
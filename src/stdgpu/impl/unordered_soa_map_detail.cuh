@@ -0,0 +1,584 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_UNORDERED_SOA_MAP_DETAIL_H
+#define STDGPU_UNORDERED_SOA_MAP_DETAIL_H
+
+#include <thrust/distance.h>
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include <stdgpu/contract.h>
+#include <stdgpu/iterator.h>
+#include <stdgpu/memory.h>
+#include <stdgpu/utility.h>
+
+
+
+namespace stdgpu
+{
+
+namespace detail
+{
+
+template <typename Key, typename T>
+inline STDGPU_HOST_DEVICE
+soa_pair_reference<Key, T>::soa_pair_reference(const Key& first,
+                                               T& second)
+    : first(first),
+      second(second)
+{
+
+}
+
+
+template <typename Key, typename T>
+inline STDGPU_HOST_DEVICE
+soa_pair_reference<Key, T>::operator thrust::pair<const Key, typename std::remove_const<T>::type>() const
+{
+    return thrust::pair<const Key, typename std::remove_const<T>::type>(first, second);
+}
+
+
+template <typename Key, typename T>
+inline STDGPU_HOST_DEVICE const typename soa_iterator<Key, T>::reference*
+soa_iterator<Key, T>::pointer::operator->() const
+{
+    return &ref;
+}
+
+
+template <typename Key, typename T>
+inline STDGPU_HOST_DEVICE
+soa_iterator<Key, T>::soa_iterator(const Key* keys,
+                                   T* mapped,
+                                   const index_t position)
+    : _keys(keys),
+      _mapped(mapped),
+      _position(position)
+{
+
+}
+
+
+template <typename Key, typename T>
+template <typename U, typename>
+inline STDGPU_HOST_DEVICE
+soa_iterator<Key, T>::soa_iterator(const soa_iterator<Key, U>& other)
+    : _keys(other._keys),
+      _mapped(other._mapped),
+      _position(other._position)
+{
+
+}
+
+
+template <typename Key, typename T>
+inline STDGPU_HOST_DEVICE typename soa_iterator<Key, T>::reference
+soa_iterator<Key, T>::operator*() const
+{
+    return reference(_keys[_position], _mapped[_position]);
+}
+
+
+template <typename Key, typename T>
+inline STDGPU_HOST_DEVICE typename soa_iterator<Key, T>::pointer
+soa_iterator<Key, T>::operator->() const
+{
+    return pointer{ **this };
+}
+
+
+template <typename Key, typename T>
+inline STDGPU_HOST_DEVICE soa_iterator<Key, T>&
+soa_iterator<Key, T>::operator++()
+{
+    ++_position;
+    return *this;
+}
+
+
+template <typename Key, typename T>
+inline STDGPU_HOST_DEVICE index_t
+soa_iterator<Key, T>::position() const
+{
+    return _position;
+}
+
+
+template <typename Key, typename T>
+inline STDGPU_HOST_DEVICE bool
+soa_iterator<Key, T>::operator==(const soa_iterator<Key, T>& other) const
+{
+    return _keys == other._keys
+        && _mapped == other._mapped
+        && _position == other._position;
+}
+
+
+template <typename Key, typename T>
+inline STDGPU_HOST_DEVICE bool
+soa_iterator<Key, T>::operator!=(const soa_iterator<Key, T>& other) const
+{
+    return !(*this == other);
+}
+
+
+template <typename Key, typename T>
+inline STDGPU_HOST_DEVICE
+soa_select<Key, T>::soa_select(const Key* keys,
+                               T* mapped)
+    : _keys(keys),
+      _mapped(mapped)
+{
+
+}
+
+
+template <typename Key, typename T>
+inline STDGPU_HOST_DEVICE soa_pair_reference<Key, T>
+soa_select<Key, T>::operator()(const index_t i) const
+{
+    return soa_pair_reference<Key, T>(_keys[i], _mapped[i]);
+}
+
+
+template <typename T>
+struct soa_mapped_payload
+{
+    T* mapped;
+    const T* value;
+
+    STDGPU_HOST_DEVICE
+    soa_mapped_payload(T* mapped,
+                       const T* value)
+        : mapped(mapped),
+          value(value)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    construct(const index_t n) const
+    {
+        STDGPU_EXPECTS(value != nullptr);
+
+        safe_device_allocator<T> a;
+        allocator_traits<safe_device_allocator<T>>::construct(a, &(mapped[n]), *value);
+    }
+
+    STDGPU_DEVICE_ONLY void
+    destroy(const index_t n) const
+    {
+        safe_device_allocator<T> a;
+        allocator_traits<safe_device_allocator<T>>::destroy(a, &(mapped[n]));
+    }
+};
+
+
+template <typename Map>
+struct soa_insert_value
+{
+    Map map;
+
+    soa_insert_value(const Map& map)
+        : map(map)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const typename Map::value_type& value)
+    {
+        map.insert(value);
+    }
+};
+
+
+template <typename Map>
+struct soa_erase_from_key
+{
+    Map map;
+
+    soa_erase_from_key(const Map& map)
+        : map(map)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const typename Map::key_type& key)
+    {
+        map.erase(key);
+    }
+};
+
+
+template <typename Base, typename T>
+struct soa_destroy_occupied_mapped
+{
+    Base base;
+    T* mapped;
+
+    soa_destroy_occupied_mapped(const Base& base,
+                                T* mapped)
+        : base(base),
+          mapped(mapped)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        if (base.occupied(i))
+        {
+            soa_mapped_payload<T>(mapped, nullptr).destroy(i);
+        }
+    }
+};
+
+} // namespace detail
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename unordered_soa_map<Key, T, Hash, KeyEqual>::allocator_type
+unordered_soa_map<Key, T, Hash, KeyEqual>::get_allocator() const
+{
+    return allocator_type();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_soa_map<Key, T, Hash, KeyEqual>::iterator
+unordered_soa_map<Key, T, Hash, KeyEqual>::begin()
+{
+    return iterator(_base._values, _mapped, 0);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_soa_map<Key, T, Hash, KeyEqual>::const_iterator
+unordered_soa_map<Key, T, Hash, KeyEqual>::begin() const
+{
+    return const_iterator(_base._values, _mapped, 0);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_soa_map<Key, T, Hash, KeyEqual>::const_iterator
+unordered_soa_map<Key, T, Hash, KeyEqual>::cbegin() const
+{
+    return begin();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_soa_map<Key, T, Hash, KeyEqual>::iterator
+unordered_soa_map<Key, T, Hash, KeyEqual>::end()
+{
+    return iterator(_base._values, _mapped, total_count());
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_soa_map<Key, T, Hash, KeyEqual>::const_iterator
+unordered_soa_map<Key, T, Hash, KeyEqual>::end() const
+{
+    return const_iterator(_base._values, _mapped, total_count());
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_soa_map<Key, T, Hash, KeyEqual>::const_iterator
+unordered_soa_map<Key, T, Hash, KeyEqual>::cend() const
+{
+    return end();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+transform_range<stdgpu::device_range<index_t>, detail::soa_select<Key, const T>>
+unordered_soa_map<Key, T, Hash, KeyEqual>::device_range() const
+{
+    // Collects the occupied positions into the range indices of the base
+    _base.device_range();
+
+    return transform_range<stdgpu::device_range<index_t>, detail::soa_select<Key, const T>>(_base._range_indices.device_range(),
+                                                                                            detail::soa_select<Key, const T>(_base._values, _mapped));
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+unordered_soa_map<Key, T, Hash, KeyEqual>::bucket(const key_type& key) const
+{
+    return _base.bucket(key);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY index_t
+unordered_soa_map<Key, T, Hash, KeyEqual>::bucket_size(index_type n) const
+{
+    return _base.bucket_size(n);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY index_t
+unordered_soa_map<Key, T, Hash, KeyEqual>::count(const key_type& key) const
+{
+    return _base.count(key);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_soa_map<Key, T, Hash, KeyEqual>::iterator
+unordered_soa_map<Key, T, Hash, KeyEqual>::find(const key_type& key)
+{
+    return iterator(_base._values, _mapped, static_cast<index_t>(thrust::distance(_base.begin(), _base.find(key))));
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY typename unordered_soa_map<Key, T, Hash, KeyEqual>::const_iterator
+unordered_soa_map<Key, T, Hash, KeyEqual>::find(const key_type& key) const
+{
+    return const_iterator(_base._values, _mapped, static_cast<index_t>(thrust::distance(_base.cbegin(), _base.find(key))));
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY bool
+unordered_soa_map<Key, T, Hash, KeyEqual>::contains(const key_type& key) const
+{
+    return _base.contains(key);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <class... Args>
+inline STDGPU_DEVICE_ONLY thrust::pair<typename unordered_soa_map<Key, T, Hash, KeyEqual>::iterator, bool>
+unordered_soa_map<Key, T, Hash, KeyEqual>::emplace(Args&&... args)
+{
+    return insert(value_type(forward<Args>(args)...));
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY thrust::pair<typename unordered_soa_map<Key, T, Hash, KeyEqual>::iterator, bool>
+unordered_soa_map<Key, T, Hash, KeyEqual>::insert(const unordered_soa_map<Key, T, Hash, KeyEqual>::value_type& value)
+{
+    // The mapped value is constructed inside the critical section before the key becomes visible
+    thrust::pair<typename decltype(_base)::iterator, bool> result = _base.insert(value.first,
+                                                                                 detail::soa_mapped_payload<T>(_mapped, &(value.second)));
+
+    return thrust::make_pair(iterator(_base._values, _mapped, static_cast<index_t>(thrust::distance(_base.begin(), result.first))),
+                             result.second);
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline void
+unordered_soa_map<Key, T, Hash, KeyEqual>::insert(device_ptr<unordered_soa_map<Key, T, Hash, KeyEqual>::value_type> begin,
+                                                  device_ptr<unordered_soa_map<Key, T, Hash, KeyEqual>::value_type> end)
+{
+    thrust::for_each(begin, end,
+                     detail::soa_insert_value<unordered_soa_map<Key, T, Hash, KeyEqual>>(*this));
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline void
+unordered_soa_map<Key, T, Hash, KeyEqual>::insert(device_ptr<const unordered_soa_map<Key, T, Hash, KeyEqual>::value_type> begin,
+                                                  device_ptr<const unordered_soa_map<Key, T, Hash, KeyEqual>::value_type> end)
+{
+    thrust::for_each(begin, end,
+                     detail::soa_insert_value<unordered_soa_map<Key, T, Hash, KeyEqual>>(*this));
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_DEVICE_ONLY index_t
+unordered_soa_map<Key, T, Hash, KeyEqual>::erase(const unordered_soa_map<Key, T, Hash, KeyEqual>::key_type& key)
+{
+    return _base.erase(key,
+                       detail::soa_mapped_payload<T>(_mapped, nullptr));
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline void
+unordered_soa_map<Key, T, Hash, KeyEqual>::erase(device_ptr<unordered_soa_map<Key, T, Hash, KeyEqual>::key_type> begin,
+                                                 device_ptr<unordered_soa_map<Key, T, Hash, KeyEqual>::key_type> end)
+{
+    thrust::for_each(begin, end,
+                     detail::soa_erase_from_key<unordered_soa_map<Key, T, Hash, KeyEqual>>(*this));
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline void
+unordered_soa_map<Key, T, Hash, KeyEqual>::erase(device_ptr<const unordered_soa_map<Key, T, Hash, KeyEqual>::key_type> begin,
+                                                 device_ptr<const unordered_soa_map<Key, T, Hash, KeyEqual>::key_type> end)
+{
+    thrust::for_each(begin, end,
+                     detail::soa_erase_from_key<unordered_soa_map<Key, T, Hash, KeyEqual>>(*this));
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE bool
+unordered_soa_map<Key, T, Hash, KeyEqual>::empty() const
+{
+    return _base.empty();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE bool
+unordered_soa_map<Key, T, Hash, KeyEqual>::full() const
+{
+    return _base.full();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+unordered_soa_map<Key, T, Hash, KeyEqual>::size() const
+{
+    return _base.size();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+unordered_soa_map<Key, T, Hash, KeyEqual>::max_size() const
+{
+    return _base.max_size();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+unordered_soa_map<Key, T, Hash, KeyEqual>::bucket_count() const
+{
+    return _base.bucket_count();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE index_t
+unordered_soa_map<Key, T, Hash, KeyEqual>::total_count() const
+{
+    return _base.total_count();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE float
+unordered_soa_map<Key, T, Hash, KeyEqual>::load_factor() const
+{
+    return _base.load_factor();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE float
+unordered_soa_map<Key, T, Hash, KeyEqual>::max_load_factor() const
+{
+    return _base.max_load_factor();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+unordered_statistics
+unordered_soa_map<Key, T, Hash, KeyEqual>::statistics() const
+{
+    return _base.statistics();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename unordered_soa_map<Key, T, Hash, KeyEqual>::hasher
+unordered_soa_map<Key, T, Hash, KeyEqual>::hash_function() const
+{
+    return _base.hash_function();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline STDGPU_HOST_DEVICE typename unordered_soa_map<Key, T, Hash, KeyEqual>::key_equal
+unordered_soa_map<Key, T, Hash, KeyEqual>::key_eq() const
+{
+    return _base.key_eq();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+bool
+unordered_soa_map<Key, T, Hash, KeyEqual>::valid() const
+{
+    return _base.valid();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+void
+unordered_soa_map<Key, T, Hash, KeyEqual>::clear()
+{
+    // Destroy the mapped values first while the occupied status still marks them as alive
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(total_count()),
+                     detail::soa_destroy_occupied_mapped<decltype(_base), T>(_base, _mapped));
+
+    _base.clear();
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+unordered_soa_map<Key, T, Hash, KeyEqual>
+unordered_soa_map<Key, T, Hash, KeyEqual>::createDeviceObject(const index_t& capacity)
+{
+    STDGPU_EXPECTS(capacity > 0);
+
+    unordered_soa_map<Key, T, Hash, KeyEqual> result;
+    result._base    = detail::unordered_base<key_type, key_type, thrust::identity<key_type>, hasher, key_equal>::createDeviceObject(capacity);
+
+    allocator_type a = result.get_allocator();      // Will be replaced by member
+    result._mapped  = allocator_traits<allocator_type>::allocate(a, result.total_count());
+
+    return result;
+}
+
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+void
+unordered_soa_map<Key, T, Hash, KeyEqual>::destroyDeviceObject(unordered_soa_map<Key, T, Hash, KeyEqual>& device_object)
+{
+    device_object.clear();
+
+    allocator_type a = device_object.get_allocator();   // Will be replaced by member
+    allocator_traits<allocator_type>::deallocate(a, device_object._mapped, device_object.total_count());
+    device_object._mapped = nullptr;
+
+    detail::unordered_base<key_type, key_type, thrust::identity<key_type>, hasher, key_equal>::destroyDeviceObject(device_object._base);
+}
+
+} // namespace stdgpu
+
+
+
+#endif // STDGPU_UNORDERED_SOA_MAP_DETAIL_H
@@ -16,6 +16,13 @@
 #ifndef STDGPU_VECTOR_DETAIL_H
 #define STDGPU_VECTOR_DETAIL_H
 
+#include <new>
+#include <type_traits>
+
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include <stdgpu/algorithm.h>
 #include <stdgpu/contract.h>
 #include <stdgpu/iterator.h>
 #include <stdgpu/memory.h>
@@ -194,6 +201,51 @@ vector<T>::push_back(const T& element)
 }
 
 
+template <typename T>
+inline STDGPU_DEVICE_ONLY thrust::pair<index_t, bool>
+vector<T>::push_back_n(const T* elements,
+                       const index_t n)
+{
+    STDGPU_EXPECTS(n >= 0);
+
+    // Reserve the whole block with a single atomic addition such that the block is contiguous
+    int push_position = _size.fetch_add(static_cast<int>(n));
+
+    if (push_position < 0 || push_position + n > _capacity)
+    {
+        // Revert the reservation, such that the size settles at the capacity once all failing calls have returned
+        _size.fetch_sub(static_cast<int>(n));
+
+        printf("stdgpu::vector::push_back_n : Not enough space left for %d elements\n", static_cast<int>(n));
+        return thrust::make_pair(stdgpu::min<index_t>(push_position, _capacity), false);
+    }
+
+    // A concurrent pop_back may already have released a reserved position by decreasing the size but still be moving its element out.
+    // Like push_back, wait until it has reset the occupancy bit, which it does without waiting on any other thread.
+    for (index_t i = 0; i < n; ++i)
+    {
+        // The fence also forces the bit to be reloaded in every iteration
+        while (occupied(push_position + i))
+        {
+            atomic_thread_fence();
+        }
+    }
+    atomic_thread_fence();
+
+    allocator_type a = get_allocator();     // Will be replaced by member
+    for (index_t i = 0; i < n; ++i)
+    {
+        allocator_traits<allocator_type>::construct(a, &(_data[push_position + i]), elements[i]);
+    }
+
+    // Mark the whole block as occupied with one atomic operation per bit block after the elements have become visible
+    atomic_thread_fence();
+    _occupied.set_bits(push_position, push_position + n);
+
+    return thrust::make_pair(static_cast<index_t>(push_position), true);
+}
+
+
 template <typename T>
 inline STDGPU_DEVICE_ONLY thrust::pair<T, bool>
 vector<T>::pop_back()
@@ -221,11 +273,14 @@ vector<T>::pop_back()
 
                 if (occupied(pop_position))
                 {
-                    bool was_occupied = _occupied.reset(pop_position);
                     allocator_type a = get_allocator();     // Will be replaced by member
                     allocator_traits<allocator_type>::construct(a, &popped, _data[pop_position], true);
                     allocator_traits<allocator_type>::destroy(a, &(_data[pop_position]));
 
+                    // push_back_n does not take the lock, so the position must only be released after the element is gone
+                    atomic_thread_fence();
+                    bool was_occupied = _occupied.reset(pop_position);
+
                     if (!was_occupied)
                     {
                         printf("stdgpu::vector::pop_back : Expected entry to be occupied but actually was not\n");
@@ -301,11 +356,214 @@ vector<T>::capacity() const
 }
 
 
+namespace detail
+{
+
+template <typename T>
+struct vector_relocate_value
+{
+    T* source;
+    T* destination;
+
+    vector_relocate_value(T* source,
+                          T* destination)
+        : source(source),
+          destination(destination)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        ::new (static_cast<void*>(&(destination[i]))) T(stdgpu::move(source[i]));
+        destroy_at(&(source[i]));
+    }
+};
+
+
+template <typename T, typename ValueIterator>
+struct vector_construct_value
+{
+    T* destination;
+    ValueIterator source;
+
+    vector_construct_value(T* destination,
+                           ValueIterator source)
+        : destination(destination),
+          source(source)
+    {
+
+    }
+
+    STDGPU_DEVICE_ONLY void
+    operator()(const index_t i)
+    {
+        ::new (static_cast<void*>(&(destination[i]))) T(source[i]);
+    }
+};
+
+} // namespace detail
+
+
+template <typename T>
+inline void
+vector<T>::reserve(const index_t new_capacity)
+{
+    STDGPU_EXPECTS(new_capacity > 0);
+
+    if (new_capacity <= capacity()) return;
+
+    reallocate(new_capacity);
+
+    STDGPU_ENSURES(capacity() == new_capacity);
+}
+
+
+template <typename T>
+inline void
+vector<T>::resize(const index_t n,
+                  const T& value)
+{
+    STDGPU_EXPECTS(n >= 0);
+
+    const index_t current_size = size();
+
+    if (n > capacity())
+    {
+        reserve(n);
+    }
+
+    if (n > current_size)
+    {
+        detail::uninitialized_fill(stdgpu::device_begin(_data) + current_size, stdgpu::device_begin(_data) + n,
+                                   value);
+
+        _occupied.set_range(current_size, n);
+    }
+    else if (n < current_size)
+    {
+        stdgpu::destroy(stdgpu::device_begin(_data) + n, stdgpu::device_begin(_data) + current_size);
+
+        _occupied.set_range(n, current_size, false);
+    }
+
+    _size.store(static_cast<int>(n));
+
+    STDGPU_ENSURES(size() == n);
+    STDGPU_ENSURES(valid());
+}
+
+
+template <typename T>
+template <typename ValueIterator>
+inline void
+vector<T>::append(ValueIterator first,
+                  ValueIterator last)
+{
+    const index_t current_size = size();
+    const index_t n = static_cast<index_t>(last - first);
+
+    STDGPU_EXPECTS(n >= 0);
+
+    if (n == 0) return;
+
+    if (current_size + n > capacity())
+    {
+        reserve(current_size + n);
+    }
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(n),
+                     detail::vector_construct_value<T, ValueIterator>(_data + current_size, first));
+
+    _occupied.set_range(current_size, current_size + n);
+
+    _size.store(static_cast<int>(current_size + n));
+
+    STDGPU_ENSURES(size() == current_size + n);
+    STDGPU_ENSURES(valid());
+}
+
+
+template <typename T>
+template <typename ValueIterator>
+inline void
+vector<T>::insert(device_ptr<const T> position,
+                  ValueIterator first,
+                  ValueIterator last)
+{
+    const index_t current_size = size();
+    const index_t insert_position = static_cast<index_t>(position - device_cbegin());
+    const index_t n = static_cast<index_t>(last - first);
+
+    STDGPU_EXPECTS(0 <= insert_position);
+    STDGPU_EXPECTS(insert_position <= current_size);
+    STDGPU_EXPECTS(n >= 0);
+
+    if (insert_position == current_size)
+    {
+        append(first, last);
+        return;
+    }
+
+    if (n == 0) return;
+
+    if (current_size + n > capacity())
+    {
+        reserve(current_size + n);
+    }
+
+    // The shifted tail may overlap with its old location, so move it out of the way first
+    const index_t tail_size = current_size - insert_position;
+
+    allocator_type a = get_allocator();     // Will be replaced by member
+    T* tail = allocator_traits<allocator_type>::allocate(a, tail_size);
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(tail_size),
+                     detail::vector_relocate_value<T>(_data + insert_position, tail));
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(n),
+                     detail::vector_construct_value<T, ValueIterator>(_data + insert_position, first));
+
+    thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(tail_size),
+                     detail::vector_relocate_value<T>(tail, _data + insert_position + n));
+
+    allocator_traits<allocator_type>::deallocate(a, tail, tail_size);
+
+    _occupied.set_range(current_size, current_size + n);
+
+    _size.store(static_cast<int>(current_size + n));
+
+    STDGPU_ENSURES(size() == current_size + n);
+    STDGPU_ENSURES(valid());
+}
+
+
+template <typename T>
+template <typename ValueIterator>
+inline void
+vector<T>::assign(ValueIterator first,
+                  ValueIterator last)
+{
+    clear();
+
+    append(first, last);
+}
+
+
 template <typename T>
 inline void
 vector<T>::shrink_to_fit()
 {
-    // Reject request for performance reasons
+    // Keep a positive capacity such that the object can be reused without calling reserve() first
+    if (empty()) return;
+
+    if (size() == capacity()) return;
+
+    reallocate(size());
+
+    STDGPU_ENSURES(capacity() == size());
+    STDGPU_ENSURES(valid());
 }
 
 
@@ -452,6 +710,47 @@ vector<T>::size_valid() const
     return (0 <= current_size && current_size <= static_cast<int>(_capacity));
 }
 
+
+
+template <typename T>
+void
+vector<T>::reallocate(const index_t new_capacity)
+{
+    STDGPU_EXPECTS(new_capacity > 0);
+    STDGPU_EXPECTS(new_capacity >= size());
+
+    const index_t current_size = size();
+
+    allocator_type a = get_allocator();     // Will be replaced by member
+    T* new_data = allocator_traits<allocator_type>::allocate(a, new_capacity);
+
+    if (current_size > 0)
+    {
+        // Trivially copyable types are relocated by a plain copy of the memory, other types are moved and destroyed in parallel
+        if (std::is_trivially_copyable<T>::value)
+        {
+            copyDevice2DeviceArray(_data, current_size, new_data);
+        }
+        else
+        {
+            thrust::for_each(thrust::counting_iterator<index_t>(0), thrust::counting_iterator<index_t>(current_size),
+                             detail::vector_relocate_value<T>(_data, new_data));
+        }
+    }
+
+    allocator_traits<allocator_type>::deallocate(a, _data, _capacity);
+    _data = new_data;
+
+    mutex_array::destroyDeviceObject(_locks);
+    _locks = mutex_array::createDeviceObject(new_capacity);
+
+    bitset::destroyDeviceObject(_occupied);
+    _occupied = bitset::createDeviceObject(new_capacity);
+    _occupied.set_range(0, current_size);
+
+    _capacity = new_capacity;
+}
+
 } // namespace stdgpu
 
 
@@ -0,0 +1,253 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_WORK_STEALING_DEQUE_DETAIL_H
+#define STDGPU_WORK_STEALING_DEQUE_DETAIL_H
+
+#include <stdgpu/contract.h>
+#include <stdgpu/memory.h>
+
+
+
+namespace stdgpu
+{
+
+template <typename T>
+work_stealing_deque<T>
+work_stealing_deque<T>::createDeviceObject(const index_t& capacity)
+{
+    STDGPU_EXPECTS(capacity > 0);
+
+    work_stealing_deque<T> result;
+    allocator_type a;   // Will be replaced by member
+    result._data     = allocator_traits<allocator_type>::allocate(a, capacity);
+    result._top      = atomic<position_type>::createDeviceObject();
+    result._bottom   = atomic<position_type>::createDeviceObject();
+    result._capacity = capacity;
+
+    return result;
+}
+
+template <typename T>
+void
+work_stealing_deque<T>::destroyDeviceObject(work_stealing_deque<T>& device_object)
+{
+    device_object.clear();
+
+    allocator_type a = device_object.get_allocator();   // Will be replaced by member
+    allocator_traits<allocator_type>::deallocate(a, device_object._data, device_object._capacity);
+    atomic<position_type>::destroyDeviceObject(device_object._top);
+    atomic<position_type>::destroyDeviceObject(device_object._bottom);
+    device_object._capacity = 0;
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE typename work_stealing_deque<T>::allocator_type
+work_stealing_deque<T>::get_allocator() const
+{
+    return allocator_type();
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY bool
+work_stealing_deque<T>::push_bottom(const T& element)
+{
+    const position_type cells = static_cast<position_type>(_capacity);
+
+    // A stale top is never larger than the current one, so the check may only report a full object too early
+    position_type bottom = _bottom.load();
+    position_type top    = _top.load();
+
+    if (bottom - top >= cells)
+    {
+        printf("stdgpu::work_stealing_deque::push_bottom : Object full\n");
+        return false;
+    }
+
+    _data[bottom % cells] = element;
+
+    // Publish the element to the thieves, which must not observe the new bottom before the element itself
+    atomic_thread_fence();
+    _bottom.store(bottom + 1);
+
+    return true;
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY thrust::pair<T, bool>
+work_stealing_deque<T>::pop_bottom()
+{
+    const position_type cells = static_cast<position_type>(_capacity);
+
+    // Announce the removal before reading the top, such that thieves and the owner cannot both take the same element
+    // The full fence orders the store of the bottom before the load of the top, the exchange alone is relaxed
+    position_type bottom = _bottom.load() - 1;
+    _bottom.exchange(bottom);
+    atomic_thread_fence();
+    position_type top = _top.load();
+
+    // Unsigned wrap-around yields the signed distance between both positions
+    long long int difference = static_cast<long long int>(bottom - top);
+
+    if (difference < 0)
+    {
+        // Empty, restore the bottom
+        _bottom.store(bottom + 1);
+        return thrust::make_pair(T(), false);
+    }
+
+    T element = _data[bottom % cells];
+
+    if (difference > 0)
+    {
+        return thrust::make_pair(element, true);
+    }
+
+    // Last element, compete with the thieves
+    position_type expected_top = top;
+    bool taken = _top.compare_exchange_strong(expected_top, top + 1);
+    _bottom.store(top + 1);
+
+    if (!taken)
+    {
+        return thrust::make_pair(T(), false);
+    }
+
+    return thrust::make_pair(element, true);
+}
+
+
+template <typename T>
+inline STDGPU_DEVICE_ONLY thrust::pair<T, bool>
+work_stealing_deque<T>::steal()
+{
+    const position_type cells = static_cast<position_type>(_capacity);
+
+    // Read the top first such that a concurrent pop_bottom can only decrease the difference
+    position_type top    = _top.load();
+    atomic_thread_fence();
+    position_type bottom = _bottom.load();
+
+    long long int difference = static_cast<long long int>(bottom - top);
+
+    if (difference <= 0)
+    {
+        return thrust::make_pair(T(), false);
+    }
+
+    // Pairs with the fence in push_bottom before publishing the bottom, such that the element is not read before it was written
+    atomic_thread_fence();
+
+    // The cell cannot be overwritten before the top has moved past it, so the read is only discarded if another thread took the element
+    T element = _data[top % cells];
+
+    if (!_top.compare_exchange_strong(top, top + 1))
+    {
+        return thrust::make_pair(T(), false);
+    }
+
+    return thrust::make_pair(element, true);
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE bool
+work_stealing_deque<T>::empty() const
+{
+    return (size() == 0);
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE bool
+work_stealing_deque<T>::full() const
+{
+    return (size() == max_size());
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE index_t
+work_stealing_deque<T>::size() const
+{
+    position_type current_top    = _top.load();
+    position_type current_bottom = _bottom.load();
+
+    long long int current_size = static_cast<long long int>(current_bottom - current_top);
+
+    // A pending pop_bottom of the last element temporarily moves the bottom below the top
+    if (current_size < 0)
+    {
+        return 0;
+    }
+    else if (current_size > static_cast<long long int>(_capacity))
+    {
+        return _capacity;
+    }
+
+    return static_cast<index_t>(current_size);
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE index_t
+work_stealing_deque<T>::max_size() const
+{
+    return capacity();
+}
+
+
+template <typename T>
+inline STDGPU_HOST_DEVICE index_t
+work_stealing_deque<T>::capacity() const
+{
+    return _capacity;
+}
+
+
+template <typename T>
+inline void
+work_stealing_deque<T>::clear()
+{
+    // Trivially copyable elements need not be destroyed
+    _top.store(0);
+    _bottom.store(0);
+
+    STDGPU_ENSURES(empty());
+    STDGPU_ENSURES(valid());
+}
+
+
+template <typename T>
+inline bool
+work_stealing_deque<T>::valid() const
+{
+    // Special case : Zero capacity is valid
+    if (capacity() == 0) return true;
+
+    position_type current_top    = _top.load();
+    position_type current_bottom = _bottom.load();
+
+    return (current_top <= current_bottom && current_bottom - current_top <= static_cast<position_type>(_capacity));
+}
+
+} // namespace stdgpu
+
+
+
+#endif // STDGPU_WORK_STEALING_DEQUE_DETAIL_H
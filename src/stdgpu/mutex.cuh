@@ -20,6 +20,7 @@
  * \file stdgpu/mutex.cuh
  */
 
+#include <stdgpu/atomic.cuh>
 #include <stdgpu/attribute.h>
 #include <stdgpu/bitset.cuh>
 #include <stdgpu/cstddef.h>
@@ -47,7 +48,7 @@ namespace stdgpu
  *  - Mutexes must be modeled as containers since threads have to call the exact same object
  *  - Manual allocation and destruction of container required
  *  - No guaranteed valid state
- *  - Blocking lock is not supported
+ *  - Blocking lock only supported on platforms where threads of a warp can progress independently, see reference::lock()
  */
 class mutex_array
 {
@@ -75,8 +76,18 @@ class mutex_array
                 STDGPU_DEVICE_ONLY bool
                 try_lock();
 
+                /**
+                 * \brief Locks the mutex and waits with exponential backoff while it is held by another thread
+                 * \note Waiting requires that the holding thread makes progress independently of the waiting one, which is the case
+                 *       for the OpenMP backend and for GPUs with independent thread scheduling (Volta and newer). On older GPUs, the
+                 *       threads of a warp may deadlock, so call try_lock() in a loop which also contains the critical section instead
+                 */
+                STDGPU_DEVICE_ONLY void
+                lock();
+
                 /**
                  * \brief Unlocks the mutex
+                 * \note All memory accesses of the critical section are visible to the next thread acquiring the mutex
                  */
                 STDGPU_DEVICE_ONLY void
                 unlock();
@@ -196,6 +207,12 @@ class mutex_ref
         STDGPU_DEVICE_ONLY bool
         try_lock();
 
+        /**
+         * \brief See mutex_array::reference
+         */
+        STDGPU_DEVICE_ONLY void
+        lock();
+
         /**
          * \brief See mutex_array::reference
          */
@@ -221,6 +238,232 @@ class mutex_ref
 };
 
 
+/**
+ * \brief A class to model a reader/writer mutex array on the GPU
+ *
+ * Each mutex is either unlocked, locked exclusively by a single writer, or locked shared by any number of readers. This allows
+ * concurrent reads of read-mostly data which is guarded per entry.
+ *
+ * Differences to std::shared_mutex:
+ *  - Mutexes must be modeled as containers since threads have to call the exact same object
+ *  - Manual allocation and destruction of container required
+ *  - No guaranteed valid state
+ *  - No writer preference, a continuous stream of readers may starve a writer
+ */
+class shared_mutex_array
+{
+    public:
+        /**
+         * \brief A proxy class to model a reader/writer mutex reference on the GPU
+         *
+         * Differences to std::shared_mutex:
+         *  - No equivalent analogue
+         *  - Additional locked functions to check the lock state of the mutex
+         */
+        class reference
+        {
+            public:
+                /**
+                 * \brief Deleted constructor
+                 */
+                STDGPU_HOST_DEVICE
+                reference() = delete;
+
+                /**
+                 * \brief Tries to lock the mutex exclusively
+                 * \return True if the mutex has been locked, false otherwise
+                 */
+                STDGPU_DEVICE_ONLY bool
+                try_lock();
+
+                /**
+                 * \brief Locks the mutex exclusively and waits with exponential backoff while it is held by other threads
+                 * \note See mutex_array::reference::lock()
+                 */
+                STDGPU_DEVICE_ONLY void
+                lock();
+
+                /**
+                 * \brief Unlocks the exclusively locked mutex
+                 */
+                STDGPU_DEVICE_ONLY void
+                unlock();
+
+                /**
+                 * \brief Tries to lock the mutex shared
+                 * \return True if the mutex has been locked, false if it is locked exclusively by another thread
+                 */
+                STDGPU_DEVICE_ONLY bool
+                try_lock_shared();
+
+                /**
+                 * \brief Locks the mutex shared and waits with exponential backoff while it is locked exclusively by another thread
+                 * \note See mutex_array::reference::lock()
+                 */
+                STDGPU_DEVICE_ONLY void
+                lock_shared();
+
+                /**
+                 * \brief Unlocks the shared locked mutex
+                 */
+                STDGPU_DEVICE_ONLY void
+                unlock_shared();
+
+                /**
+                 * \brief Checks whether the mutex is locked exclusively
+                 * \return True if the mutex is locked exclusively, false otherwise
+                 */
+                STDGPU_DEVICE_ONLY bool
+                locked() const;
+
+                /**
+                 * \brief Checks whether the mutex is locked shared
+                 * \return True if the mutex is locked shared by at least one thread, false otherwise
+                 */
+                STDGPU_DEVICE_ONLY bool
+                locked_shared() const;
+
+            private:
+                friend shared_mutex_array;
+
+                STDGPU_HOST_DEVICE
+                explicit reference(unsigned int* state);
+
+                unsigned int* _state;
+        };
+
+        /**
+         * \brief Creates an object of this class on the GPU (device)
+         * \param[in] size The size of this object
+         * \return A newly created object of this class allocated on the GPU (device)
+         */
+        static shared_mutex_array
+        createDeviceObject(const index_t& size);
+
+        /**
+         * \brief Destroys the given object of this class on the GPU (device)
+         * \param[in] device_object The object allocated on the GPU (device)
+         */
+        static void
+        destroyDeviceObject(shared_mutex_array& device_object);
+
+
+        /**
+         * \brief Empty constructor
+         */
+        shared_mutex_array() = default;
+
+        /**
+         * \brief Returns a reference to the n-th mutex
+         * \param[in] n The position of the requested mutex
+         * \return The n-th mutex
+         * \pre 0 <= n < size()
+         */
+        STDGPU_DEVICE_ONLY reference
+        operator[](const index_t n);
+
+        /**
+         * \brief Returns a reference to the n-th mutex
+         * \param[in] n The position of the requested mutex
+         * \return The n-th mutex
+         * \pre 0 <= n < size()
+         */
+        STDGPU_DEVICE_ONLY const reference
+        operator[](const index_t n) const;
+
+
+        /**
+         * \brief Checks if this object is empty
+         * \return True if this object is empty, false otherwise
+         */
+        STDGPU_NODISCARD STDGPU_HOST_DEVICE bool
+        empty() const;
+
+        /**
+         * \brief The size
+         * \return The size of the object
+         */
+        STDGPU_HOST_DEVICE index_t
+        size() const;
+
+
+        /**
+         * \brief Checks if the object is in valid state
+         * \return True if no mutex is locked, false otherwise
+         */
+        bool
+        valid() const;
+
+    private:
+        unsigned int* _states = nullptr;
+        index_t _size = 0;
+};
+
+
+/**
+ * \brief A scoped guard which locks the given mutex on construction and unlocks it on destruction
+ * \tparam Lockable The type of the mutex reference, e.g. mutex_array::reference or shared_mutex_array::reference
+ * \note The mutex is locked with lock(), see mutex_array::reference::lock() for the requirements
+ */
+template <typename Lockable>
+class lock_guard
+{
+    public:
+        /**
+         * \brief Locks the given mutex
+         * \param[in] lockable The mutex
+         */
+        STDGPU_DEVICE_ONLY explicit
+        lock_guard(Lockable lockable);
+
+        /**
+         * \brief Unlocks the mutex
+         */
+        STDGPU_DEVICE_ONLY
+        ~lock_guard();
+
+        lock_guard(const lock_guard&) = delete;
+
+        lock_guard&
+        operator=(const lock_guard&) = delete;
+
+    private:
+        Lockable _lockable;
+};
+
+
+/**
+ * \brief A scoped guard which locks the given mutex shared on construction and unlocks it on destruction
+ * \tparam SharedLockable The type of the mutex reference, e.g. shared_mutex_array::reference
+ * \note The mutex is locked with lock_shared(), see mutex_array::reference::lock() for the requirements
+ */
+template <typename SharedLockable>
+class shared_lock_guard
+{
+    public:
+        /**
+         * \brief Locks the given mutex shared
+         * \param[in] lockable The mutex
+         */
+        STDGPU_DEVICE_ONLY explicit
+        shared_lock_guard(SharedLockable lockable);
+
+        /**
+         * \brief Unlocks the mutex
+         */
+        STDGPU_DEVICE_ONLY
+        ~shared_lock_guard();
+
+        shared_lock_guard(const shared_lock_guard&) = delete;
+
+        shared_lock_guard&
+        operator=(const shared_lock_guard&) = delete;
+
+    private:
+        SharedLockable _lockable;
+};
+
+
 /**
  * \brief Tryies to lock all the locks at the given positions {lock1, lock2, ..., lockn} for some n >= 1
  * \param[in] lock1 The first lock
@@ -139,6 +139,12 @@ STDGPU_DEVICE_ONLY T
 atomic_fetch_dec_mod(T* address,
                      const T arg);
 
+/**
+ * \brief Orders all memory accesses of the calling thread before the fence with respect to all memory accesses after the fence
+ */
+STDGPU_DEVICE_ONLY void
+atomic_thread_fence();
+
 } // namespace openmp
 
 } // namespace stdgpu
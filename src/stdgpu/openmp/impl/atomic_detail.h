@@ -195,6 +195,13 @@ atomic_fetch_dec_mod(T* address,
     return old;
 }
 
+
+inline STDGPU_DEVICE_ONLY void
+atomic_thread_fence()
+{
+    #pragma omp flush
+}
+
 } // namespace openmp
 
 } // namespace stdgpu
@@ -0,0 +1,48 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_OPENMP_MUTEX_DETAIL_H
+#define STDGPU_OPENMP_MUTEX_DETAIL_H
+
+#include <chrono>
+#include <thread>
+
+
+
+namespace stdgpu
+{
+
+namespace openmp
+{
+
+inline STDGPU_DEVICE_ONLY void
+backoff(const unsigned int nanoseconds)
+{
+    // Yield rather than spin, such that a lock holder sharing the core can make progress
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(nanoseconds);
+    do
+    {
+        std::this_thread::yield();
+    }
+    while (std::chrono::steady_clock::now() < deadline);
+}
+
+} // namespace openmp
+
+} // namespace stdgpu
+
+
+
+#endif // STDGPU_OPENMP_MUTEX_DETAIL_H
@@ -191,6 +191,18 @@ namespace stdgpu
     #define STDGPU_CODE STDGPU_CODE_HOST
 #endif
 
+
+/**
+ * \def STDGPU_PREFETCH
+ * \hideinitializer
+ * \brief Platform-independent hint to load the given address into the cache, does nothing if unsupported
+ */
+#if STDGPU_CODE == STDGPU_CODE_HOST && (STDGPU_HOST_COMPILER == STDGPU_HOST_COMPILER_GCC || STDGPU_HOST_COMPILER == STDGPU_HOST_COMPILER_CLANG)
+    #define STDGPU_PREFETCH(address) __builtin_prefetch(address)
+#else
+    #define STDGPU_PREFETCH(address) static_cast<void>(address)
+#endif
+
 } // namespace stdgpu
 
 
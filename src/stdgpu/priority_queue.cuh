@@ -0,0 +1,283 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_PRIORITY_QUEUE_H
+#define STDGPU_PRIORITY_QUEUE_H
+
+/**
+ * \file stdgpu/priority_queue.cuh
+ */
+
+#include <type_traits>
+
+#include <thrust/pair.h>
+
+#include <stdgpu/atomic.cuh>
+#include <stdgpu/attribute.h>
+#include <stdgpu/cstddef.h>
+#include <stdgpu/iterator.h>
+#include <stdgpu/memory.h>
+#include <stdgpu/mutex.cuh>
+#include <stdgpu/platform.h>
+
+
+
+///////////////////////////////////////////////////////////
+
+
+#include <stdgpu/priority_queue_fwd>
+
+
+///////////////////////////////////////////////////////////
+
+
+
+namespace stdgpu
+{
+
+/**
+ * \brief A concurrent priority queue on the GPU which removes the smallest elements first
+ * \tparam T The type of the stored elements
+ * \tparam Compare The type of the comparison functor which defines the order of the elements
+ *
+ * The elements are distributed among several binary min-heaps which are protected by one lock each (MultiQueue). Insertions pick
+ * the heaps in a round-robin fashion, removals compare the smallest elements of two heaps and take the smaller one. With a single
+ * heap, the removals are exact but serialized. With more heaps, the removals are relaxed, i.e. they return one of the smallest
+ * elements rather than the smallest one, in exchange for less contention.
+ *
+ * Differences to std::priority_queue:
+ *  - The element which compares smallest is removed first, i.e. Compare = thrust::less<T> yields a min-queue
+ *  - Manual allocation and destruction of container required
+ *  - pop_min() and pop_k() are relaxed if there is more than one heap, the host function pop() is always exact
+ *  - No top(), the smallest element is only accessible by removing it
+ *  - T must be trivially copyable since the smallest elements of the heaps are inspected without holding the lock
+ *  - The object stays in a valid state when reaching the capacity limit
+ */
+template <typename T,
+          typename Compare>
+class priority_queue
+{
+    public:
+        using value_type        = T;                                        /**< T */
+        using value_compare     = Compare;                                  /**< Compare */
+
+        using allocator_type    = safe_device_allocator<T>;                 /**< safe_device_allocator<T> */
+
+        using index_type        = index_t;                                  /**< index_t */
+        using difference_type   = std::ptrdiff_t;                           /**< std::ptrdiff_t */
+
+        using reference         = value_type&;                              /**< value_type& */
+        using const_reference   = const value_type&;                        /**< const value_type& */
+        using pointer           = value_type*;                              /**< value_type* */
+        using const_pointer     = const value_type*;                        /**< const value_type* */
+
+
+        static_assert(std::is_trivially_copyable<T>::value, "stdgpu::priority_queue : T must be trivially copyable");
+
+
+        /**
+         * \brief Creates an object of this class on the GPU (device)
+         * \param[in] capacity The capacity of the object
+         * \param[in] heap_count The number of heaps
+         * \return A newly created object of this class allocated on the GPU (device)
+         * \pre capacity > 0
+         * \pre heap_count > 0
+         */
+        static priority_queue<T, Compare>
+        createDeviceObject(const index_t& capacity,
+                           const index_t& heap_count);
+
+        /**
+         * \brief Destroys the given object of this class on the GPU (device)
+         * \param[in] device_object The object allocated on the GPU (device)
+         */
+        static void
+        destroyDeviceObject(priority_queue<T, Compare>& device_object);
+
+
+        /**
+         * \brief Empty constructor
+         */
+        priority_queue() = default;
+
+        /**
+         * \brief Returns the container allocator
+         * \return The container allocator
+         */
+        STDGPU_HOST_DEVICE allocator_type
+        get_allocator() const;
+
+        /**
+         * \brief Returns the comparison functor
+         * \return The comparison functor
+         */
+        STDGPU_HOST_DEVICE value_compare
+        value_comp() const;
+
+        /**
+         * \brief Adds the element to the object
+         * \param[in] element An element
+         * \return True if not full, false otherwise
+         */
+        STDGPU_DEVICE_ONLY bool
+        push(const T& element);
+
+        /**
+         * \brief Adds the given block of elements to the object with a single reservation
+         * \param[in] elements The elements
+         * \param[in] n The number of elements
+         * \return True if the whole block fits into the object, false otherwise
+         * \pre n >= 0
+         * \note The block is either added completely or not at all
+         */
+        STDGPU_DEVICE_ONLY bool
+        push_n(const T* elements,
+               const index_t n);
+
+        /**
+         * \brief Removes and returns one of the smallest elements of the object
+         * \return The currently popped element and true if not empty, an empty element T() and false otherwise
+         * \note The element is the smallest one if the object consists of a single heap
+         */
+        STDGPU_DEVICE_ONLY thrust::pair<T, bool>
+        pop_min();
+
+        /**
+         * \brief Removes up to k of the smallest elements of the object with a single reservation
+         * \param[out] elements The popped elements, each one chosen from two heaps like in pop_min()
+         * \param[in] k The maximum number of elements
+         * \return The number of popped elements, i.e. the minimum of k and the current size
+         * \pre k >= 0
+         * \note The elements are the k smallest ones in ascending order if the object consists of a single heap
+         */
+        STDGPU_DEVICE_ONLY index_t
+        pop_k(T* elements,
+              const index_t k);
+
+        /**
+         * \brief Adds the given range of elements to the object
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         * \return True if the whole range fits into the object, false otherwise
+         * \note The range is either added completely or not at all
+         */
+        bool
+        push(device_ptr<const T> begin,
+             device_ptr<const T> end);
+
+        /**
+         * \brief Removes the smallest elements of the object into the given range in ascending order
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         * \return The number of popped elements, i.e. the minimum of the size of the range and the size of the object
+         * \note The result is exact regardless of the number of heaps, but requires sorting all elements
+         */
+        index_t
+        pop(device_ptr<T> begin,
+            device_ptr<T> end);
+
+        /**
+         * \brief Checks if the object is empty
+         * \return True if the object is empty, false otherwise
+         */
+        STDGPU_NODISCARD STDGPU_HOST_DEVICE bool
+        empty() const;
+
+        /**
+         * \brief Checks if the object is full
+         * \return True if the object is full, false otherwise
+         */
+        STDGPU_HOST_DEVICE bool
+        full() const;
+
+        /**
+         * \brief Returns the current size
+         * \return The size
+         */
+        STDGPU_HOST_DEVICE index_t
+        size() const;
+
+        /**
+         * \brief Returns the maximal size
+         * \return The maximal size
+         */
+        STDGPU_HOST_DEVICE index_t
+        max_size() const;
+
+        /**
+         * \brief Returns the capacity
+         * \return The capacity
+         */
+        STDGPU_HOST_DEVICE index_t
+        capacity() const;
+
+        /**
+         * \brief Returns the number of heaps
+         * \return The number of heaps
+         */
+        STDGPU_HOST_DEVICE index_t
+        heap_count() const;
+
+        /**
+         * \brief Clears the complete object
+         */
+        void
+        clear();
+
+        /**
+         * \brief Checks if the object is in a valid state
+         * \return True if the state is valid, false otherwise
+         */
+        bool
+        valid() const;
+
+    private:
+
+        STDGPU_DEVICE_ONLY bool
+        reserve_push(const index_t n);
+
+        STDGPU_DEVICE_ONLY index_t
+        reserve_pop(const index_t n);
+
+        STDGPU_DEVICE_ONLY index_t
+        choose_heap();
+
+        STDGPU_DEVICE_ONLY void
+        heap_push(const index_t heap,
+                  const T& element);
+
+        STDGPU_DEVICE_ONLY T
+        heap_pop(const index_t heap);
+
+        T* _data = nullptr;
+        int* _heap_sizes = nullptr;
+        mutex_array _locks = {};
+        atomic<int> _size = {};
+        atomic<unsigned int> _next = {};
+        index_t _heap_count = 0;
+        index_t _heap_capacity = 0;
+        index_t _capacity = 0;
+        value_compare _compare = {};
+};
+
+} // namespace stdgpu
+
+
+
+#include <stdgpu/impl/priority_queue_detail.cuh>
+
+
+
+#endif // STDGPU_PRIORITY_QUEUE_H
@@ -25,7 +25,9 @@
 #include <stdgpu/attribute.h>
 #include <stdgpu/cstddef.h>
 #include <stdgpu/deque.cuh>
+#include <stdgpu/iterator.h>
 #include <stdgpu/platform.h>
+#include <stdgpu/ring_buffer.cuh>
 
 
 
@@ -46,6 +48,8 @@ namespace stdgpu
  * \brief A generic container similar to std::queue on the GPU
  * \tparam T The type of the stored elements
  *
+ * The default container ring_buffer is lock-free and additionally supports the non-blocking functions try_push() and try_pop().
+ *
  * Differences to std::queue:
  *  - index_type instead of size_type
  *  - Manual allocation and destruction of container required
@@ -103,6 +107,67 @@ class queue
         STDGPU_DEVICE_ONLY thrust::pair<T, bool>
         pop();
 
+        /**
+         * \brief Add the element to the end of the queue if there is space left
+         * \param[in] element An element
+         * \return True if not full, false otherwise
+         * \note Requires ContainerT to provide try_push_back(), e.g. ring_buffer
+         */
+        STDGPU_DEVICE_ONLY bool
+        try_push(const T& element);
+
+        /**
+         * \brief Removes and returns the first element from the queue if there is one
+         * \return The currently popped element and true if not empty, an empty element T() and false otherwise
+         * \note Requires ContainerT to provide try_pop_front(), e.g. ring_buffer
+         */
+        STDGPU_DEVICE_ONLY thrust::pair<T, bool>
+        try_pop();
+
+        /**
+         * \brief Adds the given block of elements to the end of the queue with a single reservation
+         * \param[in] elements The elements
+         * \param[in] n The number of elements
+         * \return True if the whole block fits into the queue, false otherwise
+         * \pre n >= 0
+         */
+        STDGPU_DEVICE_ONLY bool
+        push_n(const T* elements,
+               const index_t n);
+
+        /**
+         * \brief Removes up to n elements from the front of the queue with a single reservation
+         * \param[out] elements The popped elements in queue order
+         * \param[in] n The maximum number of elements
+         * \return The number of popped elements
+         * \pre n >= 0
+         */
+        STDGPU_DEVICE_ONLY index_t
+        pop_n(T* elements,
+              const index_t n);
+
+        /**
+         * \brief Adds the given range of elements to the end of the queue
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         * \return True if the whole range fits into the queue, false otherwise
+         * \note Requires ContainerT to provide a host-side push_back() for ranges, e.g. ring_buffer
+         */
+        bool
+        push(device_ptr<const T> begin,
+             device_ptr<const T> end);
+
+        /**
+         * \brief Removes elements from the front of the queue into the given range
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         * \return The number of popped elements
+         * \note Requires ContainerT to provide a host-side pop_front() for ranges, e.g. ring_buffer
+         */
+        index_t
+        pop(device_ptr<T> begin,
+            device_ptr<T> end);
+
         /**
          * \brief Checks if the object is empty
          * \return True if the object is empty, false otherwise
@@ -20,6 +20,8 @@
  * \file stdgpu/ranges.h
  */
 
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
 #include <thrust/iterator/transform_iterator.h>
 
 #include <stdgpu/cstddef.h>
@@ -173,6 +175,11 @@ namespace detail
 template <typename T>
 struct select;
 
+/**
+ * \brief A functor to map from logical positions to wrapped positions in a ring of the given capacity
+ */
+struct ring_position;
+
 } // namespace detail
 
 
@@ -190,6 +197,78 @@ using device_indexed_range = transform_range<device_range<index_t>, detail::sele
 template <typename T>
 using host_indexed_range = transform_range<host_range<index_t>, detail::select<T>>;
 
+
+/**
+ * \brief A class representing a device range over the contents of a ring buffer which may wrap around the end of the array
+ * \tparam T The value type
+ *
+ * The contents consist of at most two contiguous segments [begin, capacity) and [0, end) of the array. The iterators map the logical
+ * positions to the wrapped array positions on the fly, so no indices need to be materialized.
+ */
+template <typename T>
+class device_ring_range
+{
+    public:
+        using iterator      = thrust::permutation_iterator<device_ptr<T>, thrust::transform_iterator<detail::ring_position, thrust::counting_iterator<index_t>>>;    /**< thrust::permutation_iterator<device_ptr<T>, thrust::transform_iterator<detail::ring_position, thrust::counting_iterator<index_t>>> */
+        using value_type    = typename iterator::value_type;    /**< typename iterator::value_type */
+
+        /**
+         * \brief Constructor
+         * \param[in] p A pointer to the array
+         * \param[in] capacity The number of array elements
+         * \param[in] begin The array position of the first element of the range
+         * \param[in] n The number of elements in the range
+         * \pre 0 <= begin < capacity
+         * \pre 0 <= n <= capacity
+         */
+        STDGPU_HOST_DEVICE
+        device_ring_range(T* p,
+                          index_t capacity,
+                          index_t begin,
+                          index_t n);
+
+        /**
+         * \brief An iterator to the begin of the range
+         * \return An iterator to the begin of the range
+         */
+        STDGPU_HOST_DEVICE iterator
+        begin();
+
+        /**
+         * \brief An iterator to the end of the range
+         * \return An iterator to the end of the range
+         */
+        STDGPU_HOST_DEVICE iterator
+        end();
+
+        /**
+         * \brief The number of elements in the range
+         * \return The number of elements in the range
+         */
+        STDGPU_HOST_DEVICE index_t
+        size() const;
+
+        /**
+         * \brief The contiguous segment of the range starting at the first element
+         * \return A range over the array positions [begin, min(begin + n, capacity))
+         */
+        STDGPU_HOST_DEVICE device_range<T>
+        first_segment() const;
+
+        /**
+         * \brief The contiguous segment of the range which wrapped around the end of the array
+         * \return A range over the array positions [0, end), which is empty if the range does not wrap around
+         */
+        STDGPU_HOST_DEVICE device_range<T>
+        second_segment() const;
+
+    private:
+        T* _data = nullptr;
+        index_t _capacity = 0;
+        index_t _begin = 0;
+        index_t _size = 0;
+};
+
 } // namespace stdgpu
 
 
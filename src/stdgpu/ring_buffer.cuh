@@ -0,0 +1,247 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_RING_BUFFER_H
+#define STDGPU_RING_BUFFER_H
+
+/**
+ * \file stdgpu/ring_buffer.cuh
+ */
+
+#include <thrust/pair.h>
+
+#include <stdgpu/atomic.cuh>
+#include <stdgpu/attribute.h>
+#include <stdgpu/cstddef.h>
+#include <stdgpu/iterator.h>
+#include <stdgpu/memory.h>
+#include <stdgpu/platform.h>
+
+
+
+///////////////////////////////////////////////////////////
+
+
+#include <stdgpu/ring_buffer_fwd>
+
+
+///////////////////////////////////////////////////////////
+
+
+
+namespace stdgpu
+{
+
+/**
+ * \brief A bounded lock-free FIFO container on the GPU supporting multiple concurrent producers and consumers
+ * \tparam T The type of the stored elements
+ *
+ * Every cell stores a sequence number which tells whether the cell is ready to be written by the producer or read by the consumer
+ * owning the respective position. Producers and consumers claim positions with a single successful update of the respective counter
+ * and only touch the sequence number of their own cell afterwards, so no locks and no occupancy bits are required.
+ *
+ * Differences to deque:
+ *  - Elements can only be added to the back and removed from the front
+ *  - try_push_back() and try_pop_front() report failures by their return value only, push_back() and pop_front() additionally print a warning
+ *  - The object stays in a valid state when reaching the capacity limit
+ */
+template <typename T>
+class ring_buffer
+{
+    public:
+        using value_type        = T;                                        /**< T */
+
+        using allocator_type    = safe_device_allocator<T>;                 /**< safe_device_allocator<T> */
+
+        using index_type        = index_t;                                  /**< index_t */
+        using difference_type   = std::ptrdiff_t;                           /**< std::ptrdiff_t */
+
+        using reference         = value_type&;                              /**< value_type& */
+        using const_reference   = const value_type&;                        /**< const value_type& */
+        using pointer           = value_type*;                              /**< value_type* */
+        using const_pointer     = const value_type*;                        /**< const value_type* */
+
+
+        /**
+         * \brief Creates an object of this class on the GPU (device)
+         * \param[in] capacity The capacity of the object
+         * \return A newly created object of this class allocated on the GPU (device)
+         * \pre capacity > 0
+         */
+        static ring_buffer<T>
+        createDeviceObject(const index_t& capacity);
+
+        /**
+         * \brief Destroys the given object of this class on the GPU (device)
+         * \param[in] device_object The object allocated on the GPU (device)
+         */
+        static void
+        destroyDeviceObject(ring_buffer<T>& device_object);
+
+
+        /**
+         * \brief Empty constructor
+         */
+        ring_buffer() = default;
+
+        /**
+         * \brief Returns the container allocator
+         * \return The container allocator
+         */
+        STDGPU_HOST_DEVICE allocator_type
+        get_allocator() const;
+
+        /**
+         * \brief Adds the element to the end of the object if there is space left
+         * \param[in] element An element
+         * \return True if not full, false otherwise
+         */
+        STDGPU_DEVICE_ONLY bool
+        try_push_back(const T& element);
+
+        /**
+         * \brief Removes and returns the first element of the object if there is one
+         * \return The currently popped element and true if not empty, an empty element T() and false otherwise
+         */
+        STDGPU_DEVICE_ONLY thrust::pair<T, bool>
+        try_pop_front();
+
+        /**
+         * \brief Adds the element to the end of the object
+         * \param[in] element An element
+         * \return True if not full, false otherwise
+         */
+        STDGPU_DEVICE_ONLY bool
+        push_back(const T& element);
+
+        /**
+         * \brief Removes and returns the first element of the object
+         * \return The currently popped element and true if not empty, an empty element T() and false otherwise
+         */
+        STDGPU_DEVICE_ONLY thrust::pair<T, bool>
+        pop_front();
+
+        /**
+         * \brief Adds the given block of elements to the end of the object with a single reservation
+         * \param[in] elements The elements
+         * \param[in] n The number of elements
+         * \return True if the whole block fits into the object, false otherwise
+         * \pre 0 <= n <= capacity()
+         * \note The block is either added completely and contiguously or not at all
+         */
+        STDGPU_DEVICE_ONLY bool
+        push_back_n(const T* elements,
+                    const index_t n);
+
+        /**
+         * \brief Removes up to n elements from the front of the object with a single reservation
+         * \param[out] elements The popped elements, starting with the first element of the object
+         * \param[in] n The maximum number of elements
+         * \return The number of popped elements
+         * \pre n >= 0
+         * \note Stops at the first element whose push has not finished yet
+         */
+        STDGPU_DEVICE_ONLY index_t
+        pop_front_n(T* elements,
+                    const index_t n);
+
+        /**
+         * \brief Adds the given range of elements to the end of the object
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         * \return True if the whole range fits into the object, false otherwise
+         * \note The range is either added completely or not at all
+         */
+        bool
+        push_back(device_ptr<const T> begin,
+                  device_ptr<const T> end);
+
+        /**
+         * \brief Removes elements from the front of the object into the given range
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         * \return The number of popped elements, i.e. the minimum of the size of the range and the size of the object
+         */
+        index_t
+        pop_front(device_ptr<T> begin,
+                  device_ptr<T> end);
+
+        /**
+         * \brief Checks if the object is empty
+         * \return True if the object is empty, false otherwise
+         */
+        STDGPU_NODISCARD STDGPU_HOST_DEVICE bool
+        empty() const;
+
+        /**
+         * \brief Checks if the object is full
+         * \return True if the object is full, false otherwise
+         */
+        STDGPU_HOST_DEVICE bool
+        full() const;
+
+        /**
+         * \brief Returns the current size
+         * \return The size
+         */
+        STDGPU_HOST_DEVICE index_t
+        size() const;
+
+        /**
+         * \brief Returns the maximal size
+         * \return The maximal size
+         */
+        STDGPU_HOST_DEVICE index_t
+        max_size() const;
+
+        /**
+         * \brief Returns the capacity
+         * \return The capacity
+         */
+        STDGPU_HOST_DEVICE index_t
+        capacity() const;
+
+        /**
+         * \brief Clears the complete object
+         */
+        void
+        clear();
+
+        /**
+         * \brief Checks if the object is in a valid state
+         * \return True if the state is valid, false otherwise
+         */
+        bool
+        valid() const;
+
+    private:
+        using sequence_type = unsigned long long int;
+
+        T* _data = nullptr;
+        sequence_type* _sequences = nullptr;
+        atomic<sequence_type> _begin = {};
+        atomic<sequence_type> _end = {};
+        index_t _capacity = 0;
+};
+
+} // namespace stdgpu
+
+
+
+#include <stdgpu/impl/ring_buffer_detail.cuh>
+
+
+
+#endif // STDGPU_RING_BUFFER_H
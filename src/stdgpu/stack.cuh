@@ -103,6 +103,28 @@ class stack
         STDGPU_DEVICE_ONLY thrust::pair<T, bool>
         pop();
 
+        /**
+         * \brief Adds the given block of elements to the stack with a single reservation
+         * \param[in] elements The elements, the last one ends up on top of the stack
+         * \param[in] n The number of elements
+         * \return True if the whole block fits into the stack, false otherwise
+         * \pre n >= 0
+         */
+        STDGPU_DEVICE_ONLY bool
+        push_n(const T* elements,
+               const index_t n);
+
+        /**
+         * \brief Removes up to n elements from the stack with a single reservation
+         * \param[out] elements The popped elements, starting with the top of the stack
+         * \param[in] n The maximum number of elements
+         * \return The number of popped elements
+         * \pre n >= 0
+         */
+        STDGPU_DEVICE_ONLY index_t
+        pop_n(T* elements,
+              const index_t n);
+
         /**
          * \brief Checks if the object is empty
          * \return True if the object is empty, false otherwise
@@ -0,0 +1,236 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_STATIC_MAP_H
+#define STDGPU_STATIC_MAP_H
+
+/**
+ * \file stdgpu/static_map.cuh
+ */
+
+#include <thrust/pair.h>
+
+#include <stdgpu/attribute.h>
+#include <stdgpu/cstddef.h>
+#include <stdgpu/functional.h>
+#include <stdgpu/iterator.h>
+#include <stdgpu/memory.h>
+#include <stdgpu/platform.h>
+#include <stdgpu/ranges.h>
+#include <stdgpu/impl/minimal_perfect_hash.cuh>
+
+
+
+///////////////////////////////////////////////////////////
+
+
+#include <stdgpu/static_map_fwd>
+
+
+///////////////////////////////////////////////////////////
+
+
+
+namespace stdgpu
+{
+
+/**
+ * \brief An immutable map on the GPU built in bulk from a fixed set of key-value pairs
+ * \tparam Key The key type
+ * \tparam T The mapped type
+ * \tparam Hash The type of the hash functor
+ * \tparam KeyEqual The type of the key equality functor
+ *
+ * The values are addressed by a minimal perfect hash function, so each lookup touches exactly one value and no locks, occupancy flags or
+ * excess entries are required. The memory footprint is the payload plus a few bits per key.
+ * Distinct keys with equal hash values cannot be separated by the hash function and are found by a linear search over a small fallback list.
+ *
+ * Differences to unordered_map:
+ *  - The content is fixed at construction and cannot be modified
+ *  - Duplicate keys are removed, the first occurrence in the range is kept
+ *  - Difference between begin() and end() returns size()
+ */
+template <typename Key,
+          typename T,
+          typename Hash,
+          typename KeyEqual>
+class static_map
+{
+    public:
+        using key_type          = Key;                                      /**< Key */
+        using mapped_type       = T;                                        /**< T */
+        using value_type        = thrust::pair<const Key, T>;               /**< thrust::pair<const Key, T> */
+
+        using index_type        = index_t;                                  /**< index_t */
+        using difference_type   = std::ptrdiff_t;                           /**< std::ptrdiff_t */
+
+        using key_equal         = KeyEqual;                                 /**< KeyEqual */
+        using hasher            = Hash;                                     /**< Hash */
+
+        using allocator_type    = safe_device_allocator<thrust::pair<const Key, T>>;    /**< safe_device_allocator<thrust::pair<const Key, T>> */
+
+        using const_reference   = const value_type&;                        /**< const value_type& */
+        using const_pointer     = const value_type*;                        /**< const value_type* */
+        using const_iterator    = const_pointer;                            /**< const_pointer */
+
+
+        /**
+         * \brief Creates an object of this class on the GPU (device) holding the given range of elements
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         * \note Of several elements with equal keys, only the first one in the range is stored
+         * \return A newly created object of this class allocated on the GPU (device)
+         */
+        static static_map
+        createDeviceObject(device_ptr<const value_type> begin,
+                           device_ptr<const value_type> end);
+
+        /**
+         * \brief Destroys the given object of this class on the GPU (device)
+         * \param[in] device_object The object allocated on the GPU (device)
+         */
+        static void
+        destroyDeviceObject(static_map& device_object);
+
+
+        /**
+         * \brief Empty constructor
+         */
+        static_map() = default;
+
+        /**
+         * \brief Returns the container allocator
+         * \return The container allocator
+         */
+        STDGPU_HOST_DEVICE allocator_type
+        get_allocator() const;
+
+        /**
+         * \brief Checks if the object is valid
+         * \return True if the state is valid, false otherwise
+         */
+        bool
+        valid() const;
+
+
+        /**
+         * \brief An iterator to the begin of the internal value array
+         * \return A const iterator to the begin of the object
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        begin() const;
+
+        /**
+         * \brief An iterator to the begin of the internal value array
+         * \return A const iterator to the begin of the object
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        cbegin() const;
+
+        /**
+         * \brief An iterator to the end of the internal value array
+         * \return A const iterator to the end of the object
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        end() const;
+
+        /**
+         * \brief An iterator to the end of the internal value array
+         * \return A const iterator to the end of the object
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        cend() const;
+
+
+        /**
+         * \brief Builds a range to the values in the container
+         * \return A range of the container
+         */
+        stdgpu::device_range<const value_type>
+        device_range() const;
+
+
+        /**
+         * \brief Returns the number of elements with the given key in the container
+         * \param[in] key The key
+         * \return The number of elements with the given key, i.e. 1 or 0
+         */
+        STDGPU_DEVICE_ONLY index_type
+        count(const key_type& key) const;
+
+
+        /**
+         * \brief Determines if the given key is stored in the container
+         * \param[in] key The key
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         * \note Exactly one value is accessed
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        find(const key_type& key) const;
+
+
+        /**
+         * \brief Determines if the given key is stored in the container
+         * \param[in] key The key
+         * \return True if the requested key was found, false otherwise
+         */
+        STDGPU_DEVICE_ONLY bool
+        contains(const key_type& key) const;
+
+
+        /**
+         * \brief Checks if the object is empty
+         * \return True if the object is empty, false otherwise
+         */
+        STDGPU_NODISCARD STDGPU_HOST_DEVICE bool
+        empty() const;
+
+        /**
+         * \brief The size
+         * \return The size of the object
+         */
+        STDGPU_HOST_DEVICE index_t
+        size() const;
+
+
+        /**
+         * \brief The hash function
+         * \return The hash function
+         */
+        STDGPU_HOST_DEVICE hasher
+        hash_function() const;
+
+        /**
+         * \brief The key comparator for key equality
+         * \return The key comparator for key equality
+         */
+        STDGPU_HOST_DEVICE key_equal
+        key_eq() const;
+
+    private:
+        detail::minimal_perfect_hash<key_type, hasher, key_equal> _index = {};
+        value_type* _values = nullptr;
+        key_equal _key_equal = {};
+};
+
+} // namespace stdgpu
+
+
+
+#include <stdgpu/impl/static_map_detail.cuh>
+
+
+
+#endif // STDGPU_STATIC_MAP_H
@@ -0,0 +1,197 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_TASK_POOL_H
+#define STDGPU_TASK_POOL_H
+
+/**
+ * \file stdgpu/task_pool.cuh
+ */
+
+#include <thrust/pair.h>
+
+#include <stdgpu/atomic.cuh>
+#include <stdgpu/attribute.h>
+#include <stdgpu/cstddef.h>
+#include <stdgpu/iterator.h>
+#include <stdgpu/platform.h>
+#include <stdgpu/work_stealing_deque.cuh>
+
+
+
+///////////////////////////////////////////////////////////
+
+
+#include <stdgpu/task_pool_fwd>
+
+
+///////////////////////////////////////////////////////////
+
+
+
+namespace stdgpu
+{
+
+namespace detail
+{
+
+template <typename T, typename Function>
+struct task_pool_run;
+
+} // namespace detail
+
+
+/**
+ * \brief A pool of tasks which are processed by a fixed number of workers with dynamic load balancing
+ * \tparam T The type of the tasks
+ *
+ * Every worker owns a work_stealing_deque. A worker processes the tasks of its own deque in LIFO order and steals tasks from the
+ * other workers in FIFO order once its own deque is empty, starting with its neighbour. Processing a task may spawn new tasks which
+ * are added to the deque of the processing worker. The workers stop as soon as every pushed task has been processed.
+ *
+ * Differences to deque:
+ *  - Tasks are only added with push() and only processed by run(), there is no way to remove a task without processing it
+ *  - The capacity is given per worker
+ *  - T must be trivially copyable
+ */
+template <typename T>
+class task_pool
+{
+    public:
+        using value_type        = T;                                        /**< T */
+        using deque_type        = work_stealing_deque<T>;                   /**< work_stealing_deque<T> */
+
+        using index_type        = index_t;                                  /**< index_t */
+
+
+        /**
+         * \brief Creates an object of this class on the GPU (device)
+         * \param[in] worker_count The number of workers
+         * \param[in] capacity The capacity of the deque of every worker
+         * \return A newly created object of this class allocated on the GPU (device)
+         * \pre worker_count > 0
+         * \pre capacity > 0
+         */
+        static task_pool<T>
+        createDeviceObject(const index_t& worker_count,
+                           const index_t& capacity);
+
+        /**
+         * \brief Destroys the given object of this class on the GPU (device)
+         * \param[in] device_object The object allocated on the GPU (device)
+         */
+        static void
+        destroyDeviceObject(task_pool<T>& device_object);
+
+
+        /**
+         * \brief Empty constructor
+         */
+        task_pool() = default;
+
+        /**
+         * \brief Adds a task to the deque of the given worker
+         * \param[in] worker The worker which adds the task, i.e. the worker currently processing a task during run()
+         * \param[in] task A task
+         * \return True if the deque of the worker is not full, false otherwise
+         * \pre 0 <= worker < worker_count()
+         * \note Must only be called by the given worker, a task which could not be added has to be handled by the caller
+         */
+        STDGPU_DEVICE_ONLY bool
+        push(const index_t worker,
+             const T& task);
+
+        /**
+         * \brief Distributes the given range of tasks evenly among the workers
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         * \return True if the whole range fits into the deques of the workers, false otherwise
+         * \note The range is either added completely or not at all
+         * \note Must not be called concurrently with run()
+         */
+        bool
+        push(device_ptr<const T> begin,
+             device_ptr<const T> end);
+
+        /**
+         * \brief Processes all tasks including the ones spawned during processing
+         * \tparam Function The type of the task function
+         * \param[in] f The task function, called as f(task, pool, worker) on the GPU (device) with the task, a copy of this object
+         * and the index of the processing worker
+         * \post empty()
+         * \note The workers are executed as one parallel call of the backend and wait for each other until all tasks are finished,
+         * so they must be able to make progress independently of each other
+         */
+        template <typename Function>
+        void
+        run(Function f);
+
+        /**
+         * \brief Returns the number of workers
+         * \return The number of workers
+         */
+        STDGPU_HOST_DEVICE index_t
+        worker_count() const;
+
+        /**
+         * \brief Checks if the object is empty
+         * \return True if the object is empty, false otherwise
+         */
+        STDGPU_NODISCARD bool
+        empty() const;
+
+        /**
+         * \brief Returns the number of pushed tasks which have not been processed yet
+         * \return The size
+         */
+        index_t
+        size() const;
+
+        /**
+         * \brief Clears the complete object
+         */
+        void
+        clear();
+
+        /**
+         * \brief Checks if the object is in a valid state
+         * \return True if the state is valid, false otherwise
+         */
+        bool
+        valid() const;
+
+    private:
+
+        template <typename T2, typename Function>
+        friend struct detail::task_pool_run;
+
+        STDGPU_DEVICE_ONLY thrust::pair<T, bool>
+        pop(const index_t worker);
+
+        deque_type* _deques = nullptr;                  /**< The deques of the workers, accessed on the device */
+        deque_type* _host_deques = nullptr;             /**< The deques of the workers, accessed on the host */
+        atomic<int> _pending = {};                      /**< The number of pushed tasks which have not been processed yet */
+        index_t _worker_count = 0;                      /**< The number of workers */
+};
+
+} // namespace stdgpu
+
+
+
+#include <stdgpu/impl/task_pool_detail.cuh>
+
+
+
+#endif // STDGPU_TASK_POOL_H
@@ -0,0 +1,282 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_UNORDERED_MULTIMAP_H
+#define STDGPU_UNORDERED_MULTIMAP_H
+
+/**
+ * \file stdgpu/unordered_multimap.cuh
+ */
+
+#include <thrust/pair.h>
+
+#include <stdgpu/attribute.h>
+#include <stdgpu/functional.h>
+#include <stdgpu/memory.h>
+#include <stdgpu/platform.h>
+#include <stdgpu/unordered_map.cuh>
+#include <stdgpu/impl/unordered_base.cuh>
+
+
+
+///////////////////////////////////////////////////////////
+
+
+#include <stdgpu/unordered_multimap_fwd>
+
+
+///////////////////////////////////////////////////////////
+
+
+
+namespace stdgpu
+{
+
+/**
+ * \brief A generic class similar to std::unordered_multimap on the GPU
+ * \tparam Key The key type
+ * \tparam T The mapped type
+ * \tparam Hash The type of the hash functor
+ * \tparam KeyEqual The type of the key equality functor
+ *
+ * The container is built in bulk by sorting the values by their bucket and grouping equal keys, such that all values with equal keys
+ * are stored contiguously and equal_range() is a linear scan.
+ *
+ * The container is read-only: there is no insert() or erase(), neither on the host nor on the device. To add or remove elements,
+ * build a new object from the modified range.
+ *
+ * Differences to std::unordered_multimap:
+ *  - index_type instead of size_type
+ *  - Manual allocation and destruction of container required
+ *  - Read-only, the content is fixed at construction and cannot be modified
+ *  - Additional non-standard function valid()
+ *  - Some member functions missing
+ *  - Difference between begin() and end() returns size()
+ */
+template <typename Key,
+          typename T,
+          typename Hash,
+          typename KeyEqual>
+class unordered_multimap
+{
+    public:
+        using key_type          = Key;                                      /**< Key */
+        using mapped_type       = T;                                        /**< T */
+        using value_type        = thrust::pair<const Key, T>;               /**< thrust::pair<const Key, T> */
+
+        using index_type        = index_t;                                  /**< index_t */
+        using difference_type   = std::ptrdiff_t;                           /**< std::ptrdiff_t */
+
+        using key_equal         = KeyEqual;                                 /**< KeyEqual */
+        using hasher            = Hash;                                     /**< Hash */
+
+        using allocator_type    = safe_device_allocator<thrust::pair<const Key, T>>;    /**< safe_device_allocator<thrust::pair<const Key, T>> */
+
+        using const_reference   = const value_type&;                        /**< const value_type& */
+        using const_pointer     = const value_type*;                        /**< const value_type* */
+        using const_iterator    = const_pointer;                            /**< const_pointer */
+
+
+        /**
+         * \brief Creates an object of this class on the GPU (device) holding the given range of elements
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         * \return A newly created object of this class allocated on the GPU (device)
+         */
+        static unordered_multimap
+        createDeviceObject(device_ptr<const value_type> begin,
+                           device_ptr<const value_type> end);
+
+        /**
+         * \brief Creates an object of this class on the GPU (device) holding the given keys and mapped values
+         * \param[in] key_begin The begin of the key range
+         * \param[in] key_end The end of the key range
+         * \param[in] mapped_begin The begin of the mapped value range with the same length as the key range
+         * \return A newly created object of this class allocated on the GPU (device)
+         */
+        static unordered_multimap
+        createDeviceObject(device_ptr<const key_type> key_begin,
+                           device_ptr<const key_type> key_end,
+                           device_ptr<const mapped_type> mapped_begin);
+
+        /**
+         * \brief Destroys the given object of this class on the GPU (device)
+         * \param[in] device_object The object allocated on the GPU (device)
+         */
+        static void
+        destroyDeviceObject(unordered_multimap& device_object);
+
+
+        /**
+         * \brief Empty constructor
+         */
+        unordered_multimap() = default;
+
+        /**
+         * \brief Returns the container allocator
+         * \return The container allocator
+         */
+        STDGPU_HOST_DEVICE allocator_type
+        get_allocator() const;
+
+        /**
+         * \brief Checks if the object is valid
+         * \return True if the state is valid, false otherwise
+         */
+        bool
+        valid() const;
+
+
+        /**
+         * \brief An iterator to the begin of the internal value array
+         * \return A const iterator to the begin of the object
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        begin() const;
+
+        /**
+         * \brief An iterator to the begin of the internal value array
+         * \return A const iterator to the begin of the object
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        cbegin() const;
+
+        /**
+         * \brief An iterator to the end of the internal value array
+         * \return A const iterator to the end of the object
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        end() const;
+
+        /**
+         * \brief An iterator to the end of the internal value array
+         * \return A const iterator to the end of the object
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        cend() const;
+
+
+        /**
+         * \brief Builds a range to the values in the container
+         * \return A range of the container
+         */
+        stdgpu::device_range<const value_type>
+        device_range() const;
+
+
+        /**
+         * \brief Returns the bucket to which the given key is mapped
+         * \param[in] key The key
+         * \return The bucket of the key
+         * \post result < bucket_count()
+         */
+        STDGPU_HOST_DEVICE index_type
+        bucket(const key_type& key) const;
+
+
+        /**
+         * \brief Returns the number of elements in the requested container bucket
+         * \param[in] n The bucket index
+         * \return The number of elements in the requested bucket
+         */
+        STDGPU_DEVICE_ONLY index_type
+        bucket_size(index_type n) const;
+
+
+        /**
+         * \brief Returns the number of elements with the given key in the container
+         * \param[in] key The key
+         * \return The number of elements with the given key
+         */
+        STDGPU_DEVICE_ONLY index_type
+        count(const key_type& key) const;
+
+
+        /**
+         * \brief Determines if the given key is stored in the container
+         * \param[in] key The key
+         * \return An iterator to the first position of the requested key if it was found, end() otherwise
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        find(const key_type& key) const;
+
+
+        /**
+         * \brief Determines if the given key is stored in the container
+         * \param[in] key The key
+         * \return True if the requested key was found, false otherwise
+         */
+        STDGPU_DEVICE_ONLY bool
+        contains(const key_type& key) const;
+
+
+        /**
+         * \brief Returns the range of elements with the given key in the container
+         * \param[in] key The key
+         * \return A pair of iterators to the first and behind the last element with the given key, or (end(), end()) if it was not found
+         */
+        STDGPU_DEVICE_ONLY thrust::pair<const_iterator, const_iterator>
+        equal_range(const key_type& key) const;
+
+
+        /**
+         * \brief Checks if the object is empty
+         * \return True if the object is empty, false otherwise
+         */
+        STDGPU_NODISCARD STDGPU_HOST_DEVICE bool
+        empty() const;
+
+        /**
+         * \brief The size
+         * \return The size of the object
+         */
+        STDGPU_HOST_DEVICE index_t
+        size() const;
+
+        /**
+         * \brief The bucket count
+         * \return The number of bucket entries
+         */
+        STDGPU_HOST_DEVICE index_t
+        bucket_count() const;
+
+
+        /**
+         * \brief The hash function
+         * \return The hash function
+         */
+        STDGPU_HOST_DEVICE hasher
+        hash_function() const;
+
+        /**
+         * \brief The key comparator for key equality
+         * \return The key comparator for key equality
+         */
+        STDGPU_HOST_DEVICE key_equal
+        key_eq() const;
+
+    private:
+        detail::unordered_frozen_base<key_type, value_type, detail::select1st<value_type>, hasher, key_equal> _base = {};
+};
+
+} // namespace stdgpu
+
+
+
+#include <stdgpu/impl/unordered_multimap_detail.cuh>
+
+
+
+#endif // STDGPU_UNORDERED_MULTIMAP_H
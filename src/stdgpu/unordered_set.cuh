@@ -43,6 +43,22 @@
 namespace stdgpu
 {
 
+/**
+ * \brief The read-only snapshot of an unordered_set returned by unordered_set::freeze()
+ * \tparam Key The key type
+ * \tparam Hash The type of the hash functor
+ * \tparam KeyEqual The type of the key equality functor
+ *
+ * All values are stored contiguously and sorted by their bucket, so lookups require no locks or occupancy flags.
+ * Supports find(), contains(), count(), equal_range(), bucket(), bucket_size(), begin(), end(), device_range(), size(), empty(), bucket_count(),
+ * hash_function(), key_eq() and valid(). The snapshot is released by unordered_set::thaw() or destroyDeviceObject().
+ */
+template <typename Key,
+          typename Hash = hash<Key>,
+          typename KeyEqual = thrust::equal_to<Key>>
+using unordered_frozen_set = detail::unordered_frozen_base<Key, Key, thrust::identity<Key>, Hash, KeyEqual>;
+
+
 /**
  * \brief A generic container similar to std::unordered_set on the GPU
  * \tparam Key The key type
@@ -85,6 +101,8 @@ class unordered_set
         using iterator          = const_pointer;                            /**< const_pointer */
         using const_iterator    = const_pointer;                            /**< const_pointer */
 
+        using frozen_type       = unordered_frozen_set<Key, Hash, KeyEqual>;         /**< unordered_frozen_set<Key, Hash, KeyEqual> */
+
 
         /**
          * \deprecated Replaced by createDeviceObject(const index_t& capacity)
@@ -117,6 +135,24 @@ class unordered_set
         static void
         destroyDeviceObject(unordered_set& device_object);
 
+        /**
+         * \brief Converts the given object into a read-only snapshot with a compact layout optimized for lookups
+         * \param[in] device_object The object allocated on the GPU (device)
+         * \return A newly created read-only snapshot holding the values of the object
+         * \post device_object is destroyed
+         */
+        static frozen_type
+        freeze(unordered_set& device_object);
+
+        /**
+         * \brief Converts the given read-only snapshot back into a mutable object
+         * \param[in] frozen_object The read-only snapshot allocated on the GPU (device)
+         * \return A newly created object with the same capacity holding the values of the snapshot
+         * \post frozen_object is destroyed
+         */
+        static unordered_set
+        thaw(frozen_type& frozen_object);
+
 
         /**
          * \brief Empty constructor
@@ -243,6 +279,138 @@ class unordered_set
         contains(const key_type& key) const;
 
 
+        /**
+         * \brief Determines if the given key is stored in the container
+         * \param[in] key The key
+         * \param[in] hash The precomputed hash of the key
+         * \pre hash == hash_function()(key)
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         */
+        STDGPU_DEVICE_ONLY iterator
+        find(const key_type& key,
+             const std::size_t hash);
+
+        /**
+         * \brief Determines if the given key is stored in the container
+         * \param[in] key The key
+         * \param[in] hash The precomputed hash of the key
+         * \pre hash == hash_function()(key)
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        find(const key_type& key,
+             const std::size_t hash) const;
+
+        /**
+         * \brief Determines if the given key is stored in the container
+         * \param[in] key The key
+         * \param[in] hash The precomputed hash of the key
+         * \pre hash == hash_function()(key)
+         * \return True if the requested key was found, false otherwise
+         */
+        STDGPU_DEVICE_ONLY bool
+        contains(const key_type& key,
+                 const std::size_t hash) const;
+
+
+        /**
+         * \brief Determines if a key equivalent to the given one is stored in the container
+         * \tparam KeyLike A type which can be hashed and compared to key_type by the transparent hasher and key_equal
+         * \param[in] key The key-like object
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         */
+        template <typename KeyLike, typename = detail::transparent_key_t<hasher, key_equal, KeyLike>>
+        STDGPU_DEVICE_ONLY iterator
+        find(const KeyLike& key);
+
+        /**
+         * \brief Determines if a key equivalent to the given one is stored in the container
+         * \tparam KeyLike A type which can be hashed and compared to key_type by the transparent hasher and key_equal
+         * \param[in] key The key-like object
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         */
+        template <typename KeyLike, typename = detail::transparent_key_t<hasher, key_equal, KeyLike>>
+        STDGPU_DEVICE_ONLY const_iterator
+        find(const KeyLike& key) const;
+
+        /**
+         * \brief Determines if a key equivalent to the given one is stored in the container
+         * \tparam KeyLike A type which can be hashed and compared to key_type by the transparent hasher and key_equal
+         * \param[in] key The key-like object
+         * \return True if the requested key was found, false otherwise
+         */
+        template <typename KeyLike, typename = detail::transparent_key_t<hasher, key_equal, KeyLike>>
+        STDGPU_DEVICE_ONLY bool
+        contains(const KeyLike& key) const;
+
+        /**
+         * \brief Determines if a key equivalent to the given one is stored in the container
+         * \tparam KeyLike A type which can be hashed and compared to key_type by the transparent hasher and key_equal
+         * \param[in] key The key-like object
+         * \param[in] hash The precomputed hash of the key-like object
+         * \pre hash == hash_function()(key)
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         */
+        template <typename KeyLike, typename = detail::transparent_key_t<hasher, key_equal, KeyLike>>
+        STDGPU_DEVICE_ONLY iterator
+        find(const KeyLike& key,
+             const std::size_t hash);
+
+        /**
+         * \brief Determines if a key equivalent to the given one is stored in the container
+         * \tparam KeyLike A type which can be hashed and compared to key_type by the transparent hasher and key_equal
+         * \param[in] key The key-like object
+         * \param[in] hash The precomputed hash of the key-like object
+         * \pre hash == hash_function()(key)
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         */
+        template <typename KeyLike, typename = detail::transparent_key_t<hasher, key_equal, KeyLike>>
+        STDGPU_DEVICE_ONLY const_iterator
+        find(const KeyLike& key,
+             const std::size_t hash) const;
+
+        /**
+         * \brief Determines if a key equivalent to the given one is stored in the container
+         * \tparam KeyLike A type which can be hashed and compared to key_type by the transparent hasher and key_equal
+         * \param[in] key The key-like object
+         * \param[in] hash The precomputed hash of the key-like object
+         * \pre hash == hash_function()(key)
+         * \return True if the requested key was found, false otherwise
+         */
+        template <typename KeyLike, typename = detail::transparent_key_t<hasher, key_equal, KeyLike>>
+        STDGPU_DEVICE_ONLY bool
+        contains(const KeyLike& key,
+                 const std::size_t hash) const;
+
+
+        /**
+         * \brief Determines if the given keys are stored in the container
+         * \param[in] begin The begin of the range of keys
+         * \param[in] end The end of the range of keys
+         * \param[out] result The begin of the output range storing whether the respective key was found
+         * \param[in] strategy The lookup strategy
+         */
+        void
+        contains(device_ptr<const key_type> begin,
+                 device_ptr<const key_type> end,
+                 device_ptr<bool> result,
+                 const unordered_lookup strategy = unordered_lookup::independent) const;
+
+
+        /**
+         * \brief Determines if the given keys are stored in the container
+         * \param[in] begin The begin of the range of keys
+         * \param[in] end The end of the range of keys
+         * \param[out] result The begin of the output range storing an iterator to the position of the respective key if it was found, end() otherwise
+         * \param[in] strategy The lookup strategy
+         */
+        void
+        find(device_ptr<const key_type> begin,
+             device_ptr<const key_type> end,
+             device_ptr<const_iterator> result,
+             const unordered_lookup strategy = unordered_lookup::independent) const;
+
+
         /**
          * \brief Inserts the given value into the container
          * \param[in] args The arguments to construct the element
@@ -282,6 +450,44 @@ class unordered_set
                device_ptr<const value_type> end);
 
 
+        /**
+         * \brief Inserts the given range of elements into the container and collects the newly inserted ones
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         * \return A range of the values which were not contained before and got inserted
+         * \note The returned range shares its buffer with device_range() and is invalidated by the next call to either function
+         */
+        device_indexed_range<const value_type>
+        insert_unique(device_ptr<value_type> begin,
+                      device_ptr<value_type> end);
+
+
+        /**
+         * \brief Inserts the given range of elements into the container and collects the newly inserted ones
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         * \return A range of the values which were not contained before and got inserted
+         * \note The returned range shares its buffer with device_range() and is invalidated by the next call to either function
+         */
+        device_indexed_range<const value_type>
+        insert_unique(device_ptr<const value_type> begin,
+                      device_ptr<const value_type> end);
+
+
+        /**
+         * \brief Inserts the given range of host elements into the container by staging them in device chunks
+         * \param[in] begin The begin of the host range
+         * \param[in] end The end of the host range
+         * \param[in] chunk_size The maximum number of elements copied to the device at once
+         * \pre chunk_size > 0
+         * \note The additional device memory is bounded by chunk_size elements instead of the size of the whole range
+         */
+        void
+        insert_from_host(host_ptr<const value_type> begin,
+                         host_ptr<const value_type> end,
+                         const index_t chunk_size = 1048576);
+
+
         /**
          * \brief Deletes the value with the given key from the container
          * \param[in] key The key
@@ -311,12 +517,41 @@ class unordered_set
               device_ptr<const key_type> end);
 
 
+        /**
+         * \brief Deletes all values satisfying the given predicate from the container
+         * \param[in] pred The unary predicate called with the stored value
+         * \return The number of erased values
+         * \note The slots are scanned in parallel and matching values are erased by their position without searching for their keys
+         */
+        template <typename UnaryPredicate>
+        index_type
+        erase_if(UnaryPredicate pred);
+
+
+        /**
+         * \brief Moves all values of the given container whose keys are not contained in this container
+         * \param[in] source The container from which the values are extracted
+         * \note Values whose keys are already contained remain in source
+         * \pre source refers to a different object than this container
+         */
+        void
+        merge(unordered_set& source);
+
+
         /**
          * \brief Clears the complete object
          */
         void
         clear();
 
+        /**
+         * \brief Rebuilds all chains such that no erased entries remain linked and the excess entries of each bucket are stored consecutively
+         * \return The mean probe length before and after the compaction
+         * \note Must not be called concurrently with any other operation on the object
+         */
+        unordered_compaction
+        compact();
+
 
         /**
          * \brief Checks if the object is empty
@@ -387,6 +622,14 @@ class unordered_set
         max_load_factor() const;
 
 
+        /**
+         * \brief Computes occupancy and probe length statistics of the container in parallel
+         * \return The statistics of the container
+         */
+        unordered_statistics
+        statistics() const;
+
+
         /**
          * \brief The hash function
          * \return The hash function
@@ -405,6 +648,96 @@ class unordered_set
         detail::unordered_base<key_type, value_type, thrust::identity<key_type>, hasher, key_equal> _base = {};
 };
 
+
+/**
+ * \brief Inserts the values of both containers into the result, preferring the values of a for keys contained in both
+ * \param[in] a A container
+ * \param[in] b Another container
+ * \param[out] result The output to which the values are added
+ * \pre result refers to a different object than a and b
+ * \note Values not fitting into the result due to its capacity are discarded
+ */
+template <typename Key, typename Hash, typename KeyEqual>
+void
+set_union(const unordered_set<Key, Hash, KeyEqual>& a,
+          const unordered_set<Key, Hash, KeyEqual>& b,
+          unordered_set<Key, Hash, KeyEqual>& result);
+
+
+/**
+ * \brief Inserts the values of both containers into the result, preferring the values of a for keys contained in both
+ * \param[in] a A container
+ * \param[in] b Another container
+ * \param[out] result The output to which the values are added
+ * \pre result refers to a different object than a and b
+ * \note The values are appended in arbitrary order and values exceeding the capacity of result are discarded
+ */
+template <typename Key, typename Hash, typename KeyEqual>
+void
+set_union(const unordered_set<Key, Hash, KeyEqual>& a,
+          const unordered_set<Key, Hash, KeyEqual>& b,
+          vector<Key>& result);
+
+
+/**
+ * \brief Inserts the values of a whose keys are contained in b into the result
+ * \param[in] a A container
+ * \param[in] b Another container
+ * \param[out] result The output to which the values are added
+ * \pre result refers to a different object than a and b
+ * \note Values not fitting into the result due to its capacity are discarded
+ */
+template <typename Key, typename Hash, typename KeyEqual>
+void
+set_intersection(const unordered_set<Key, Hash, KeyEqual>& a,
+                 const unordered_set<Key, Hash, KeyEqual>& b,
+                 unordered_set<Key, Hash, KeyEqual>& result);
+
+
+/**
+ * \brief Inserts the values of a whose keys are contained in b into the result
+ * \param[in] a A container
+ * \param[in] b Another container
+ * \param[out] result The output to which the values are added
+ * \pre result refers to a different object than a and b
+ * \note The values are appended in arbitrary order and values exceeding the capacity of result are discarded
+ */
+template <typename Key, typename Hash, typename KeyEqual>
+void
+set_intersection(const unordered_set<Key, Hash, KeyEqual>& a,
+                 const unordered_set<Key, Hash, KeyEqual>& b,
+                 vector<Key>& result);
+
+
+/**
+ * \brief Inserts the values of a whose keys are not contained in b into the result
+ * \param[in] a A container
+ * \param[in] b Another container
+ * \param[out] result The output to which the values are added
+ * \pre result refers to a different object than a and b
+ * \note Values not fitting into the result due to its capacity are discarded
+ */
+template <typename Key, typename Hash, typename KeyEqual>
+void
+set_difference(const unordered_set<Key, Hash, KeyEqual>& a,
+               const unordered_set<Key, Hash, KeyEqual>& b,
+               unordered_set<Key, Hash, KeyEqual>& result);
+
+
+/**
+ * \brief Inserts the values of a whose keys are not contained in b into the result
+ * \param[in] a A container
+ * \param[in] b Another container
+ * \param[out] result The output to which the values are added
+ * \pre result refers to a different object than a and b
+ * \note The values are appended in arbitrary order and values exceeding the capacity of result are discarded
+ */
+template <typename Key, typename Hash, typename KeyEqual>
+void
+set_difference(const unordered_set<Key, Hash, KeyEqual>& a,
+               const unordered_set<Key, Hash, KeyEqual>& b,
+               vector<Key>& result);
+
 } // namespace stdgpu
 
 
@@ -0,0 +1,318 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_UNORDERED_SHARDED_MAP_H
+#define STDGPU_UNORDERED_SHARDED_MAP_H
+
+/**
+ * \file stdgpu/unordered_sharded_map.cuh
+ */
+
+#include <thrust/pair.h>
+
+#include <stdgpu/attribute.h>
+#include <stdgpu/cstddef.h>
+#include <stdgpu/iterator.h>
+#include <stdgpu/platform.h>
+#include <stdgpu/unordered_map.cuh>
+
+
+
+///////////////////////////////////////////////////////////
+
+
+#include <stdgpu/unordered_sharded_map_fwd>
+
+
+///////////////////////////////////////////////////////////
+
+
+
+namespace stdgpu
+{
+
+/**
+ * \brief A generic class similar to std::unordered_map on the GPU which partitions the key space into independent shards
+ * \tparam Key The key type
+ * \tparam T The mapped type
+ * \tparam Hash The type of the hash functor
+ * \tparam KeyEqual The type of the key equality functor
+ *
+ * Each key is assigned to one of several unordered_map shards by a mix of its hash which is independent of the bucket selection within
+ * the shard. Every shard owns its own value, offset, lock and occupancy arrays which are allocated separately, so operations on keys of
+ * different shards never contend for the same locks or occupancy blocks. Shards are not bound to particular threads or memory nodes:
+ * the initialization of each shard as well as the bulk insert() and erase() functions spread their work over all threads.
+ *
+ * Differences to unordered_map:
+ *  - find() and insert() return iterators into the owning shard and the sentinel end() on failure, there is no iteration over all values
+ *  - No device_range(), freeze(), thaw(), compact(), erase_if() and accumulate()
+ *  - The capacity is distributed evenly among the shards
+ */
+template <typename Key,
+          typename T,
+          typename Hash,
+          typename KeyEqual>
+class unordered_sharded_map
+{
+    public:
+        using shard_type        = unordered_map<Key, T, Hash, KeyEqual>;       /**< unordered_map<Key, T, Hash, KeyEqual> */
+
+        using key_type          = typename shard_type::key_type;               /**< Key */
+        using mapped_type       = typename shard_type::mapped_type;            /**< T */
+        using value_type        = typename shard_type::value_type;             /**< thrust::pair<const Key, T> */
+
+        using index_type        = index_t;                                      /**< index_t */
+        using difference_type   = std::ptrdiff_t;                               /**< std::ptrdiff_t */
+
+        using key_equal         = KeyEqual;                                     /**< KeyEqual */
+        using hasher            = Hash;                                         /**< Hash */
+
+        using iterator          = typename shard_type::iterator;               /**< value_type* */
+        using const_iterator    = typename shard_type::const_iterator;         /**< const value_type* */
+
+
+        /**
+         * \brief Creates an object of this class on the GPU (device)
+         * \param[in] capacity The capacity of the object
+         * \param[in] shard_count The number of shards
+         * \pre capacity > 0
+         * \pre shard_count > 0
+         * \return A newly created object of this class allocated on the GPU (device)
+         */
+        static unordered_sharded_map
+        createDeviceObject(const index_t& capacity,
+                           const index_t& shard_count);
+
+        /**
+         * \brief Destroys the given object of this class on the GPU (device)
+         * \param[in] device_object The object allocated on the GPU (device)
+         */
+        static void
+        destroyDeviceObject(unordered_sharded_map& device_object);
+
+
+        /**
+         * \brief Empty constructor
+         */
+        unordered_sharded_map() = default;
+
+
+        /**
+         * \brief The sentinel iterator returned by find() and insert() if no value could be found or inserted
+         * \return An iterator which does not point to any value
+         */
+        STDGPU_DEVICE_ONLY iterator
+        end();
+
+        /**
+         * \brief The sentinel iterator returned by find() if no value could be found
+         * \return A const iterator which does not point to any value
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        end() const;
+
+        /**
+         * \brief The sentinel iterator returned by find() if no value could be found
+         * \return A const iterator which does not point to any value
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        cend() const;
+
+
+        /**
+         * \brief The number of shards
+         * \return The number of shards
+         */
+        STDGPU_HOST_DEVICE index_t
+        shard_count() const;
+
+        /**
+         * \brief Returns the shard to which the given key is mapped
+         * \param[in] key The key
+         * \return The shard of the key
+         * \post result < shard_count()
+         */
+        STDGPU_HOST_DEVICE index_type
+        shard(const key_type& key) const;
+
+
+        /**
+         * \brief Returns the number of elements with the given key in the container
+         * \param[in] key The key
+         * \return The number of elements with the given key, i.e. 1 or 0
+         */
+        STDGPU_DEVICE_ONLY index_type
+        count(const key_type& key) const;
+
+
+        /**
+         * \brief Determines if the given key is stored in the container
+         * \param[in] key The key
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         */
+        STDGPU_DEVICE_ONLY iterator
+        find(const key_type& key);
+
+        /**
+         * \brief Determines if the given key is stored in the container
+         * \param[in] key The key
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        find(const key_type& key) const;
+
+
+        /**
+         * \brief Determines if the given key is stored in the container
+         * \param[in] key The key
+         * \return True if the requested key was found, false otherwise
+         */
+        STDGPU_DEVICE_ONLY bool
+        contains(const key_type& key) const;
+
+
+        /**
+         * \brief Inserts the given value into the container
+         * \param[in] args The arguments to construct the element
+         * \return An iterator to the inserted pair and true if the insertion was successful, end() and false otherwise
+         */
+        template <class... Args>
+        STDGPU_DEVICE_ONLY thrust::pair<iterator, bool>
+        emplace(Args&&... args);
+
+        /**
+         * \brief Inserts the given value into the container
+         * \param[in] value The new value
+         * \return An iterator to the inserted pair and true if the insertion was successful, end() and false otherwise
+         */
+        STDGPU_DEVICE_ONLY thrust::pair<iterator, bool>
+        insert(const value_type& value);
+
+
+        /**
+         * \brief Inserts the given range of elements into the container
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         */
+        void
+        insert(device_ptr<value_type> begin,
+               device_ptr<value_type> end);
+
+
+        /**
+         * \brief Inserts the given range of elements into the container
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         */
+        void
+        insert(device_ptr<const value_type> begin,
+               device_ptr<const value_type> end);
+
+
+        /**
+         * \brief Deletes the value with the given key from the container
+         * \param[in] key The key
+         * \return 1 if there was a value with key and it got erased, 0 otherwise
+         */
+        STDGPU_DEVICE_ONLY index_type
+        erase(const key_type& key);
+
+
+        /**
+         * \brief Deletes the values with the given range of keys from the container
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         */
+        void
+        erase(device_ptr<key_type> begin,
+              device_ptr<key_type> end);
+
+
+        /**
+         * \brief Deletes the values with the given range of keys from the container
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         */
+        void
+        erase(device_ptr<const key_type> begin,
+              device_ptr<const key_type> end);
+
+
+        /**
+         * \brief Checks if the object is empty
+         * \return True if the object is empty, false otherwise
+         */
+        STDGPU_NODISCARD bool
+        empty() const;
+
+        /**
+         * \brief The size
+         * \return The size of the object
+         */
+        index_t
+        size() const;
+
+        /**
+         * \brief The maximum size
+         * \return The maximum size
+         */
+        index_t
+        max_size() const;
+
+
+        /**
+         * \brief The hash function
+         * \return The hash function
+         */
+        STDGPU_HOST_DEVICE hasher
+        hash_function() const;
+
+        /**
+         * \brief The key comparator for key equality
+         * \return The key comparator for key equality
+         */
+        STDGPU_HOST_DEVICE key_equal
+        key_eq() const;
+
+
+        /**
+         * \brief Checks if the object is valid
+         * \return True if the state of every shard is valid and every value is stored in the shard of its key, false otherwise
+         */
+        bool
+        valid() const;
+
+        /**
+         * \brief Clears the complete object
+         */
+        void
+        clear();
+
+    private:
+        shard_type* _shards = nullptr;                  /**< The shards, accessed on the device */
+        shard_type* _host_shards = nullptr;             /**< The shards, accessed on the host */
+        index_t _shard_count = 0;                       /**< The number of shards */
+        hasher _hash = {};                              /**< The hashing function */
+};
+
+} // namespace stdgpu
+
+
+
+#include <stdgpu/impl/unordered_sharded_map_detail.cuh>
+
+
+
+#endif // STDGPU_UNORDERED_SHARDED_MAP_H
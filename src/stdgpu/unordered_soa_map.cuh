@@ -0,0 +1,569 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_UNORDERED_SOA_MAP_H
+#define STDGPU_UNORDERED_SOA_MAP_H
+
+/**
+ * \file stdgpu/unordered_soa_map.cuh
+ */
+
+#include <type_traits>
+
+#include <thrust/functional.h>
+#include <thrust/pair.h>
+
+#include <stdgpu/attribute.h>
+#include <stdgpu/functional.h>
+#include <stdgpu/memory.h>
+#include <stdgpu/platform.h>
+#include <stdgpu/ranges.h>
+#include <stdgpu/impl/unordered_base.cuh>
+
+
+
+///////////////////////////////////////////////////////////
+
+
+#include <stdgpu/unordered_soa_map_fwd>
+
+
+///////////////////////////////////////////////////////////
+
+
+
+namespace stdgpu
+{
+
+namespace detail
+{
+
+/**
+ * \brief A pair-like reference to a key and its mapped value which are stored in separate arrays
+ * \tparam Key The key type
+ * \tparam T The (possibly const-qualified) mapped type
+ */
+template <typename Key, typename T>
+struct soa_pair_reference
+{
+    using first_type    = const Key;                                            /**< const Key */
+    using second_type   = T;                                                    /**< T */
+
+    /**
+     * \brief Constructor
+     * \param[in] first The key
+     * \param[in] second The mapped value
+     */
+    STDGPU_HOST_DEVICE
+    soa_pair_reference(const Key& first,
+                       T& second);
+
+    /**
+     * \brief Converts the reference into a copy of the referenced pair
+     * \return A copy of the referenced key and mapped value
+     */
+    STDGPU_HOST_DEVICE
+    operator thrust::pair<const Key, typename std::remove_const<T>::type>() const;
+
+    const Key& first;       /**< The key */
+    T& second;              /**< The mapped value */
+};
+
+
+/**
+ * \brief An iterator over the entries of a container which stores keys and mapped values in separate arrays
+ * \tparam Key The key type
+ * \tparam T The (possibly const-qualified) mapped type
+ */
+template <typename Key, typename T>
+class soa_iterator
+{
+    public:
+        using value_type        = thrust::pair<const Key, typename std::remove_const<T>::type>;    /**< thrust::pair<const Key, T> */
+        using reference         = soa_pair_reference<Key, T>;                                       /**< soa_pair_reference<Key, T> */
+        using difference_type   = std::ptrdiff_t;                                                   /**< std::ptrdiff_t */
+
+        /**
+         * \brief Helper to provide member access via operator-> for the proxy reference
+         */
+        struct pointer
+        {
+            reference ref;      /**< The referenced entry */
+
+            /**
+             * \brief Member access
+             * \return A pointer to the referenced entry
+             */
+            STDGPU_HOST_DEVICE const reference*
+            operator->() const;
+        };
+
+        /**
+         * \brief Empty constructor
+         */
+        soa_iterator() = default;
+
+        /**
+         * \brief Constructor
+         * \param[in] keys The key array
+         * \param[in] mapped The mapped value array
+         * \param[in] position The position of the entry
+         */
+        STDGPU_HOST_DEVICE
+        soa_iterator(const Key* keys,
+                     T* mapped,
+                     const index_t position);
+
+        /**
+         * \brief Conversion from a mutable to a const iterator
+         * \param[in] other The iterator to a mutable mapped value
+         */
+        template <typename U,
+                  typename = typename std::enable_if<std::is_same<const U, T>::value && !std::is_same<U, T>::value>::type>
+        STDGPU_HOST_DEVICE
+        soa_iterator(const soa_iterator<Key, U>& other);     //NOLINT(hicpp-explicit-conversions)
+
+        /**
+         * \brief Dereferences the iterator
+         * \return A pair-like reference to the key and mapped value
+         */
+        STDGPU_HOST_DEVICE reference
+        operator*() const;
+
+        /**
+         * \brief Member access
+         * \return A helper object providing member access to the key and mapped value
+         */
+        STDGPU_HOST_DEVICE pointer
+        operator->() const;
+
+        /**
+         * \brief Advances the iterator to the next position
+         * \return The advanced iterator
+         */
+        STDGPU_HOST_DEVICE soa_iterator&
+        operator++();
+
+        /**
+         * \brief The position of the entry within the container
+         * \return The position of the entry
+         */
+        STDGPU_HOST_DEVICE index_t
+        position() const;
+
+        /**
+         * \brief Checks whether both iterators point at the same entry
+         * \param[in] other The other iterator
+         * \return True if both point at the same entry, false otherwise
+         */
+        STDGPU_HOST_DEVICE bool
+        operator==(const soa_iterator& other) const;
+
+        /**
+         * \brief Checks whether both iterators point at different entries
+         * \param[in] other The other iterator
+         * \return True if both point at different entries, false otherwise
+         */
+        STDGPU_HOST_DEVICE bool
+        operator!=(const soa_iterator& other) const;
+
+    private:
+        template <typename K, typename U>
+        friend class soa_iterator;
+
+        const Key* _keys = nullptr;
+        T* _mapped = nullptr;
+        index_t _position = 0;
+};
+
+
+/**
+ * \brief Selects the entry at the given position of a container which stores keys and mapped values in separate arrays
+ * \tparam Key The key type
+ * \tparam T The (possibly const-qualified) mapped type
+ */
+template <typename Key, typename T>
+struct soa_select
+{
+    /**
+     * \brief Constructor
+     * \param[in] keys The key array
+     * \param[in] mapped The mapped value array
+     */
+    STDGPU_HOST_DEVICE
+    soa_select(const Key* keys,
+               T* mapped);
+
+    /**
+     * \brief Selects the entry at the given position
+     * \param[in] i The position
+     * \return A pair-like reference to the key and mapped value
+     */
+    STDGPU_HOST_DEVICE soa_pair_reference<Key, T>
+    operator()(const index_t i) const;
+
+    const Key* _keys;       /**< The key array */
+    T* _mapped;             /**< The mapped value array */
+};
+
+} // namespace detail
+
+
+/**
+ * \brief A generic class similar to std::unordered_map on the GPU which stores the keys and the mapped values in separate arrays
+ * \tparam Key The key type
+ * \tparam T The mapped type
+ * \tparam Hash The type of the hash functor
+ * \tparam KeyEqual The type of the key equality functor
+ *
+ * The keys are kept in a dense array which is the only one touched while probing the chains, so large mapped types do not pollute the
+ * cache during lookups. The mapped value of an entry is stored at the same position in a parallel array and is constructed before the
+ * entry becomes visible to other threads.
+ *
+ * Differences to unordered_map:
+ *  - Iterators and device_range() yield pair-like proxy references with members first and second instead of value_type&
+ *  - Lookup-optimized layout only, no freeze(), thaw(), compact(), erase_if(), accumulate() and insert_or_assign()
+ */
+template <typename Key,
+          typename T,
+          typename Hash,
+          typename KeyEqual>
+class unordered_soa_map
+{
+    public:
+        using key_type          = Key;                                      /**< Key */
+        using mapped_type       = T;                                        /**< T */
+        using value_type        = thrust::pair<const Key, T>;               /**< thrust::pair<const Key, T> */
+
+        using index_type        = index_t;                                  /**< index_t */
+        using difference_type   = std::ptrdiff_t;                           /**< std::ptrdiff_t */
+
+        using key_equal         = KeyEqual;                                 /**< KeyEqual */
+        using hasher            = Hash;                                     /**< Hash */
+
+        using allocator_type    = safe_device_allocator<T>;                 /**< safe_device_allocator<T> */
+
+        using reference         = detail::soa_pair_reference<Key, T>;          /**< detail::soa_pair_reference<Key, T> */
+        using const_reference   = detail::soa_pair_reference<Key, const T>;    /**< detail::soa_pair_reference<Key, const T> */
+        using iterator          = detail::soa_iterator<Key, T>;                /**< detail::soa_iterator<Key, T> */
+        using const_iterator    = detail::soa_iterator<Key, const T>;          /**< detail::soa_iterator<Key, const T> */
+
+
+        /**
+         * \brief Creates an object of this class on the GPU (device)
+         * \param[in] capacity The capacity of the object
+         * \pre capacity > 0
+         * \return A newly created object of this class allocated on the GPU (device)
+         */
+        static unordered_soa_map
+        createDeviceObject(const index_t& capacity);
+
+        /**
+         * \brief Destroys the given object of this class on the GPU (device)
+         * \param[in] device_object The object allocated on the GPU (device)
+         */
+        static void
+        destroyDeviceObject(unordered_soa_map& device_object);
+
+
+        /**
+         * \brief Empty constructor
+         */
+        unordered_soa_map() = default;
+
+        /**
+         * \brief Returns the allocator of the mapped values
+         * \return The allocator of the mapped values
+         */
+        STDGPU_HOST_DEVICE allocator_type
+        get_allocator() const;
+
+
+        /**
+         * \brief An iterator to the begin of the internal arrays
+         * \return An iterator to the begin of the object
+         */
+        STDGPU_DEVICE_ONLY iterator
+        begin();
+
+        /**
+         * \brief An iterator to the begin of the internal arrays
+         * \return A const iterator to the begin of the object
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        begin() const;
+
+        /**
+         * \brief An iterator to the begin of the internal arrays
+         * \return A const iterator to the begin of the object
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        cbegin() const;
+
+        /**
+         * \brief An iterator to the end of the internal arrays
+         * \return An iterator to the end of the object
+         */
+        STDGPU_DEVICE_ONLY iterator
+        end();
+
+        /**
+         * \brief An iterator to the end of the internal arrays
+         * \return A const iterator to the end of the object
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        end() const;
+
+        /**
+         * \brief An iterator to the end of the internal arrays
+         * \return A const iterator to the end of the object
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        cend() const;
+
+
+        /**
+         * \brief Builds a range to the occupied entries in the container
+         * \return A range of pair-like references to the entries of the container
+         */
+        transform_range<stdgpu::device_range<index_t>, detail::soa_select<Key, const T>>
+        device_range() const;
+
+
+        /**
+         * \brief Returns the bucket to which the given key is mapped
+         * \param[in] key The key
+         * \return The bucket of the key
+         */
+        STDGPU_HOST_DEVICE index_type
+        bucket(const key_type& key) const;
+
+        /**
+         * \brief Returns the number of elements in the requested bucket
+         * \param[in] n The bucket index
+         * \return The number of elements in the requested bucket
+         */
+        STDGPU_DEVICE_ONLY index_type
+        bucket_size(index_type n) const;
+
+
+        /**
+         * \brief Returns the number of elements with the given key in the container
+         * \param[in] key The key
+         * \return The number of elements with the given key, i.e. 1 or 0
+         */
+        STDGPU_DEVICE_ONLY index_type
+        count(const key_type& key) const;
+
+
+        /**
+         * \brief Determines if the given key is stored in the container
+         * \param[in] key The key
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         * \note Only the keys are accessed during the search
+         */
+        STDGPU_DEVICE_ONLY iterator
+        find(const key_type& key);
+
+        /**
+         * \brief Determines if the given key is stored in the container
+         * \param[in] key The key
+         * \return An iterator to the position of the requested key if it was found, end() otherwise
+         * \note Only the keys are accessed during the search
+         */
+        STDGPU_DEVICE_ONLY const_iterator
+        find(const key_type& key) const;
+
+
+        /**
+         * \brief Determines if the given key is stored in the container
+         * \param[in] key The key
+         * \return True if the requested key was found, false otherwise
+         */
+        STDGPU_DEVICE_ONLY bool
+        contains(const key_type& key) const;
+
+
+        /**
+         * \brief Inserts the given value into the container
+         * \param[in] args The arguments to construct the element
+         * \return An iterator to the inserted pair and true if the insertion was successful, end() and false otherwise
+         */
+        template <class... Args>
+        STDGPU_DEVICE_ONLY thrust::pair<iterator, bool>
+        emplace(Args&&... args);
+
+
+        /**
+         * \brief Inserts the given value into the container
+         * \param[in] value The new value
+         * \return An iterator to the inserted pair and true if the insertion was successful, end() and false otherwise
+         */
+        STDGPU_DEVICE_ONLY thrust::pair<iterator, bool>
+        insert(const value_type& value);
+
+
+        /**
+         * \brief Inserts the given range of elements into the container
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         */
+        void
+        insert(device_ptr<value_type> begin,
+               device_ptr<value_type> end);
+
+        /**
+         * \brief Inserts the given range of elements into the container
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         */
+        void
+        insert(device_ptr<const value_type> begin,
+               device_ptr<const value_type> end);
+
+
+        /**
+         * \brief Deletes the value with the given key from the container
+         * \param[in] key The key
+         * \return 1 if there was a value with key and it got erased, 0 otherwise
+         */
+        STDGPU_DEVICE_ONLY index_type
+        erase(const key_type& key);
+
+
+        /**
+         * \brief Deletes the values with the given range of keys from the container
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         */
+        void
+        erase(device_ptr<key_type> begin,
+              device_ptr<key_type> end);
+
+        /**
+         * \brief Deletes the values with the given range of keys from the container
+         * \param[in] begin The begin of the range
+         * \param[in] end The end of the range
+         */
+        void
+        erase(device_ptr<const key_type> begin,
+              device_ptr<const key_type> end);
+
+
+        /**
+         * \brief Checks if the object is empty
+         * \return True if the object is empty, false otherwise
+         */
+        STDGPU_NODISCARD STDGPU_HOST_DEVICE bool
+        empty() const;
+
+        /**
+         * \brief Checks if the object is full
+         * \return True if the object is full, false otherwise
+         */
+        STDGPU_HOST_DEVICE bool
+        full() const;
+
+        /**
+         * \brief The size
+         * \return The size of the object
+         */
+        STDGPU_HOST_DEVICE index_t
+        size() const;
+
+        /**
+         * \brief The maximum size
+         * \return The maximum size
+         */
+        STDGPU_HOST_DEVICE index_t
+        max_size() const;
+
+        /**
+         * \brief The bucket count
+         * \return The number of bucket entries
+         */
+        STDGPU_HOST_DEVICE index_t
+        bucket_count() const;
+
+
+        /**
+         * \brief The average number of elements per bucket
+         * \return The average number of elements per bucket
+         */
+        STDGPU_HOST_DEVICE float
+        load_factor() const;
+
+        /**
+         * \brief The maximum number of elements per bucket
+         * \return The maximum number of elements per bucket
+         */
+        STDGPU_HOST_DEVICE float
+        max_load_factor() const;
+
+
+        /**
+         * \brief Computes occupancy and probe length statistics of the container in parallel
+         * \return The statistics of the container
+         */
+        unordered_statistics
+        statistics() const;
+
+
+        /**
+         * \brief The hash function
+         * \return The hash function
+         */
+        STDGPU_HOST_DEVICE hasher
+        hash_function() const;
+
+        /**
+         * \brief The key comparator for key equality
+         * \return The key comparator for key equality
+         */
+        STDGPU_HOST_DEVICE key_equal
+        key_eq() const;
+
+
+        /**
+         * \brief Checks if the object is valid
+         * \return True if the state is valid, false otherwise
+         */
+        bool
+        valid() const;
+
+
+        /**
+         * \brief Clears the complete object
+         */
+        void
+        clear();
+
+    private:
+        STDGPU_HOST_DEVICE index_t
+        total_count() const;
+
+        detail::unordered_base<key_type, key_type, thrust::identity<key_type>, hasher, key_equal> _base = {};
+        mapped_type* _mapped = nullptr;
+};
+
+} // namespace stdgpu
+
+
+
+#include <stdgpu/impl/unordered_soa_map_detail.cuh>
+
+
+
+#endif // STDGPU_UNORDERED_SOA_MAP_H
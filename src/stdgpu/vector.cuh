@@ -54,7 +54,7 @@ namespace stdgpu
  * Differences to std::vector:
  *  - index_type instead of size_type
  *  - Manual allocation and destruction of container required
- *  - max_size and capacity limited to initially allocated size
+ *  - max_size and capacity limited to currently allocated size, only changed on the host by reserve(), resize() and shrink_to_fit()
  *  - No guaranteed valid state when reaching capacity limit
  *  - Additional non-standard capacity functions full() and valid()
  *  - Some member functions missing
@@ -189,6 +189,21 @@ class vector
         STDGPU_DEVICE_ONLY bool
         push_back(const T& element);
 
+        /**
+         * \brief Adds the given block of elements to the end of the object with a single reservation
+         * \param[in] elements The elements
+         * \param[in] n The number of elements
+         * \return The position of the first added element and true if the whole block fits into the object, the current size and false otherwise
+         * \pre n >= 0
+         * \note The block is either added completely and contiguously or not at all
+         * \note Like push_back, a call may fail while a concurrent call that exceeded the capacity has not yet reverted its reservation
+         * \note Like push_back, the call waits for concurrent pop_back calls to finish moving out the elements at the reserved positions.
+         *       On GPUs without independent thread scheduling, this wait may not make progress if the pop_back call runs in the same warp.
+         */
+        STDGPU_DEVICE_ONLY thrust::pair<index_t, bool>
+        push_back_n(const T* elements,
+                    const index_t n);
+
         /**
          * \brief Removes and returns the current element from end of the object
          * \return The currently popped element and true if not empty, an empty element T() and false otherwise
@@ -232,8 +247,77 @@ class vector
         capacity() const;
 
         /**
-         * \brief Requests to shrink the capacity to the current size
-         * \note This is non-binding and may not have any effect
+         * \brief Increases the capacity to at least the given value and relocates the stored elements
+         * \param[in] new_capacity The new capacity
+         * \pre new_capacity > 0
+         * \note Has no effect if new_capacity <= capacity()
+         * \note Must not be called concurrently with any device operations and invalidates all copies, pointers and ranges of the object
+         */
+        void
+        reserve(const index_t new_capacity);
+
+        /**
+         * \brief Changes the size to the given value, appending copies of value or destroying the last elements
+         * \param[in] n The new size
+         * \param[in] value The value to copy into the appended elements
+         * \pre n >= 0
+         * \post size() == n
+         * \note Increases the capacity to n via reserve() if necessary
+         * \note Must not be called concurrently with any device operations and invalidates all copies, pointers and ranges of the object
+         */
+        void
+        resize(const index_t n,
+               const T& value = T());
+
+        /**
+         * \brief Appends copies of the given range of elements to the end of the object
+         * \tparam ValueIterator The type of the random access iterators pointing to the elements on the GPU (device)
+         * \param[in] first The begin of the range
+         * \param[in] last The end of the range
+         * \pre first <= last
+         * \note Increases the capacity via reserve() if necessary and copies the elements in parallel
+         * \note Must not be called concurrently with any device operations and invalidates all copies, pointers and ranges of the object if reallocated
+         */
+        template <typename ValueIterator>
+        void
+        append(ValueIterator first,
+               ValueIterator last);
+
+        /**
+         * \brief Inserts copies of the given range of elements before the given position
+         * \tparam ValueIterator The type of the random access iterators pointing to the elements on the GPU (device)
+         * \param[in] position A pointer to the element before which the range is inserted
+         * \param[in] first The begin of the range
+         * \param[in] last The end of the range
+         * \pre device_cbegin() <= position <= device_cend()
+         * \pre first <= last
+         * \note Increases the capacity via reserve() if necessary, shifts the following elements and copies the range in parallel
+         * \note Must not be called concurrently with any device operations and invalidates all copies, pointers and ranges of the object if reallocated
+         */
+        template <typename ValueIterator>
+        void
+        insert(device_ptr<const T> position,
+               ValueIterator first,
+               ValueIterator last);
+
+        /**
+         * \brief Replaces the contents of the object by copies of the given range of elements
+         * \tparam ValueIterator The type of the random access iterators pointing to the elements on the GPU (device)
+         * \param[in] first The begin of the range
+         * \param[in] last The end of the range
+         * \pre first <= last
+         * \note Increases the capacity via reserve() if necessary and copies the elements in parallel
+         * \note Must not be called concurrently with any device operations and invalidates all copies, pointers and ranges of the object if reallocated
+         */
+        template <typename ValueIterator>
+        void
+        assign(ValueIterator first,
+               ValueIterator last);
+
+        /**
+         * \brief Shrinks the capacity to the current size and relocates the stored elements
+         * \note Has no effect on empty objects since the capacity must stay positive
+         * \note Must not be called concurrently with any device operations and invalidates all copies, pointers and ranges of the object
          */
         void
         shrink_to_fit();
@@ -332,6 +416,9 @@ class vector
         bool
         size_valid() const;
 
+        void
+        reallocate(const index_t new_capacity);
+
         T* _data = nullptr;
         mutex_array _locks = {};
         bitset _occupied = {};
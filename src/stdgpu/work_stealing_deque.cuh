@@ -0,0 +1,201 @@
+/*
+ *  Copyright 2019 Patrick Stotko
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef STDGPU_WORK_STEALING_DEQUE_H
+#define STDGPU_WORK_STEALING_DEQUE_H
+
+/**
+ * \file stdgpu/work_stealing_deque.cuh
+ */
+
+#include <type_traits>
+
+#include <thrust/pair.h>
+
+#include <stdgpu/atomic.cuh>
+#include <stdgpu/attribute.h>
+#include <stdgpu/cstddef.h>
+#include <stdgpu/memory.h>
+#include <stdgpu/platform.h>
+
+
+
+///////////////////////////////////////////////////////////
+
+
+#include <stdgpu/work_stealing_deque_fwd>
+
+
+///////////////////////////////////////////////////////////
+
+
+
+namespace stdgpu
+{
+
+/**
+ * \brief A bounded lock-free deque on the GPU with a single owner and multiple thieves (Chase-Lev)
+ * \tparam T The type of the stored elements
+ *
+ * The owner adds and removes elements at the bottom end like a stack, while any other thread may steal elements from the top end.
+ * The owner only competes with the thieves for the very last element, so both ends work without locks and the top is only updated
+ * by a single successful compare-and-swap per steal.
+ *
+ * Differences to deque:
+ *  - push_bottom() and pop_bottom() must only be called by the single owner of the object, steal() may be called by any thread
+ *  - steal() may fail if it competes with another thief or the owner for the same element even if the object is not empty
+ *  - T must be trivially copyable since thieves read an element before they know whether they actually take it
+ *  - The object stays in a valid state when reaching the capacity limit
+ */
+template <typename T>
+class work_stealing_deque
+{
+    public:
+        using value_type        = T;                                        /**< T */
+
+        using allocator_type    = safe_device_allocator<T>;                 /**< safe_device_allocator<T> */
+
+        using index_type        = index_t;                                  /**< index_t */
+        using difference_type   = std::ptrdiff_t;                           /**< std::ptrdiff_t */
+
+        using reference         = value_type&;                              /**< value_type& */
+        using const_reference   = const value_type&;                        /**< const value_type& */
+        using pointer           = value_type*;                              /**< value_type* */
+        using const_pointer     = const value_type*;                        /**< const value_type* */
+
+
+        static_assert(std::is_trivially_copyable<T>::value, "stdgpu::work_stealing_deque : T must be trivially copyable");
+
+
+        /**
+         * \brief Creates an object of this class on the GPU (device)
+         * \param[in] capacity The capacity of the object
+         * \return A newly created object of this class allocated on the GPU (device)
+         * \pre capacity > 0
+         */
+        static work_stealing_deque<T>
+        createDeviceObject(const index_t& capacity);
+
+        /**
+         * \brief Destroys the given object of this class on the GPU (device)
+         * \param[in] device_object The object allocated on the GPU (device)
+         */
+        static void
+        destroyDeviceObject(work_stealing_deque<T>& device_object);
+
+
+        /**
+         * \brief Empty constructor
+         */
+        work_stealing_deque() = default;
+
+        /**
+         * \brief Returns the container allocator
+         * \return The container allocator
+         */
+        STDGPU_HOST_DEVICE allocator_type
+        get_allocator() const;
+
+        /**
+         * \brief Adds the element to the bottom of the object
+         * \param[in] element An element
+         * \return True if not full, false otherwise
+         * \note Must only be called by the owner of the object
+         */
+        STDGPU_DEVICE_ONLY bool
+        push_bottom(const T& element);
+
+        /**
+         * \brief Removes and returns the bottom element of the object
+         * \return The currently popped element and true if not empty, an empty element T() and false otherwise
+         * \note Must only be called by the owner of the object
+         */
+        STDGPU_DEVICE_ONLY thrust::pair<T, bool>
+        pop_bottom();
+
+        /**
+         * \brief Removes and returns the top element of the object
+         * \return The currently stolen element and true if successful, an empty element T() and false otherwise
+         * \note May fail if another thread takes the same element concurrently
+         */
+        STDGPU_DEVICE_ONLY thrust::pair<T, bool>
+        steal();
+
+        /**
+         * \brief Checks if the object is empty
+         * \return True if the object is empty, false otherwise
+         */
+        STDGPU_NODISCARD STDGPU_HOST_DEVICE bool
+        empty() const;
+
+        /**
+         * \brief Checks if the object is full
+         * \return True if the object is full, false otherwise
+         */
+        STDGPU_HOST_DEVICE bool
+        full() const;
+
+        /**
+         * \brief Returns the current size
+         * \return The size
+         */
+        STDGPU_HOST_DEVICE index_t
+        size() const;
+
+        /**
+         * \brief Returns the maximal size
+         * \return The maximal size
+         */
+        STDGPU_HOST_DEVICE index_t
+        max_size() const;
+
+        /**
+         * \brief Returns the capacity
+         * \return The capacity
+         */
+        STDGPU_HOST_DEVICE index_t
+        capacity() const;
+
+        /**
+         * \brief Clears the complete object
+         */
+        void
+        clear();
+
+        /**
+         * \brief Checks if the object is in a valid state
+         * \return True if the state is valid, false otherwise
+         */
+        bool
+        valid() const;
+
+    private:
+        using position_type = unsigned long long int;
+
+        T* _data = nullptr;
+        atomic<position_type> _top = {};
+        atomic<position_type> _bottom = {};
+        index_t _capacity = 0;
+};
+
+} // namespace stdgpu
+
+
+
+#include <stdgpu/impl/work_stealing_deque_detail.cuh>
+
+
+
+#endif // STDGPU_WORK_STEALING_DEQUE_H